@@ -0,0 +1,37 @@
+/*  examples/topics/ini_compile.c  */
+
+#include <stdio.h>
+#include <confini.h>
+
+int main () {
+
+  const char * const ini_path = "../ini_files/pacman.conf";
+  IniFormat my_format = INI_DEFAULT_FORMAT;
+  const IniImage * image;
+  IniImageNode node;
+
+  /*  Compile the image only when it is missing or stale  */
+  if (
+    !(image = ini_image_open(ini_path, "pacman.conf.img", my_format)) && (
+      ini_compile(ini_path, "pacman.conf.img", my_format) ||
+      !(image = ini_image_open(ini_path, "pacman.conf.img", my_format))
+    )
+  ) {
+
+    fprintf(stderr, "Sorry, something went wrong :-(\n");
+    return 1;
+
+  }
+
+  if (!ini_image_find(image, "options", "holdpkg", &node)) {
+
+    printf("HoldPkg: %s\n", node.value);
+
+  }
+
+  printf("The image contains %zu nodes\n", ini_image_get_length(image));
+  ini_image_close(image);
+  return 0;
+
+}
+
@@ -0,0 +1,55 @@
+/*  examples/topics/ini_reader_next.c  */
+
+#include <stdio.h>
+#include <confini.h>
+
+int main () {
+
+  char ini_buffer[] =
+    "[users]\n"
+    "alice = admin\n"
+    "bob = guest\n"
+    "\n"
+    "[server]\n"
+    "port = 8080\n"
+    "host = localhost\n"
+  ;
+
+  IniReader reader = ini_reader_init(
+    ini_buffer,
+    sizeof(ini_buffer) - 1,
+    INI_DEFAULT_FORMAT
+  );
+
+  IniDispatch * dispatch;
+  int retval;
+
+  /*  Print the keys, then stop at the first section that is not `users`  */
+  while (!(retval = ini_reader_next(&reader, &dispatch))) {
+
+    if (dispatch->type == INI_SECTION) {
+
+      if (!ini_string_match_ss("users", dispatch->data, dispatch->format)) {
+
+        break;
+
+      }
+
+    } else if (dispatch->type == INI_KEY) {
+
+      printf("%s is %s\n", dispatch->data, dispatch->value);
+
+    }
+
+  }
+
+  if (retval & CONFINI_ERROR) {
+
+    fprintf(stderr, "Sorry, something went wrong :-(\n");
+    return 1;
+
+  }
+
+  return 0;
+
+}
@@ -0,0 +1,53 @@
+/*  examples/topics/ini_stream_feed.c  */
+
+#include <stdio.h>
+#include <confini.h>
+
+static int my_callback (
+  IniDispatch * const dispatch,
+  void * const v_null
+) {
+
+  printf(
+    "DATA: %s\nVALUE: %s\nNODE TYPE: %u\n\n",
+    dispatch->data, dispatch->value, dispatch->type
+  );
+
+  return 0;
+
+}
+
+int main () {
+
+  char chunk[512];
+  size_t chunk_len;
+  int retval = 0;
+
+  IniStream * const stream =
+    ini_stream_open(INI_DEFAULT_FORMAT, my_callback, NULL);
+
+  if (!stream) {
+
+    fprintf(stderr, "Sorry, not enough memory :-(\n");
+    return 1;
+
+  }
+
+  /*  Parse the standard input while it arrives  */
+  while (!retval && (chunk_len = fread(chunk, 1, sizeof(chunk), stdin))) {
+
+    retval = ini_stream_feed(stream, chunk, chunk_len);
+
+  }
+
+  if (ini_stream_close(stream) || retval) {
+
+    fprintf(stderr, "Sorry, something went wrong :-(\n");
+    return 1;
+
+  }
+
+  return 0;
+
+}
+
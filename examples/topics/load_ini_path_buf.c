@@ -0,0 +1,57 @@
+/*  examples/topics/load_ini_path_buf.c  */
+
+#include <stdio.h>
+#include <confini.h>
+
+static int my_callback (
+  IniDispatch * const dispatch,
+  void * const v_null
+) {
+
+  printf(
+    "DATA: %s\nVALUE: %s\nNODE TYPE: %u\n\n",
+    dispatch->data, dispatch->value, dispatch->type
+  );
+
+  return 0;
+
+}
+
+int main () {
+
+  static const char * const paths[] = {
+    "../ini_files/delivery.conf",
+    "../ini_files/pacman.conf",
+    "../ini_files/unix-like.conf"
+  };
+
+  IniLoadBuffer buffer = { NULL, 0 };
+  int retval = 0;
+
+  /*  The same heap buffer is reused for all the files  */
+  for (size_t idx = 0; idx < sizeof(paths) / sizeof(char *); idx++) {
+
+    if (
+      load_ini_path_buf(
+        paths[idx],
+        &buffer,
+        INI_DEFAULT_FORMAT,
+        NULL,
+        my_callback,
+        NULL
+      )
+    ) {
+
+      fprintf(stderr, "Sorry, something went wrong :-(\n");
+      retval = 1;
+      break;
+
+    }
+
+  }
+
+  ini_load_buffer_free(&buffer);
+  return retval;
+
+}
+
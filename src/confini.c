@@ -200,6 +200,36 @@
 
 
 
+	@struct     IniLoadBuffer
+
+	@property   IniLoadBuffer::cache
+	                The heap memory owned by the buffer, or `NULL`
+	@property   IniLoadBuffer::size
+	                The size in bytes of #IniLoadBuffer::cache
+
+
+
+	@struct     IniImageNode
+
+	@property   IniImageNode::type
+	                The node type (see `enum` #IniNodeType)
+	@property   IniImageNode::data
+	                A comment, a section path or a key name, as it was dispatched
+	                when the image was compiled; it cannot be `NULL`
+	@property   IniImageNode::value
+	                The value of the node as it was dispatched when the image was
+	                compiled, or `NULL`
+	@property   IniImageNode::append_to
+	                The section path of the node; it cannot be `NULL`
+	@property   IniImageNode::d_len
+	                The length of the string #IniImageNode::data
+	@property   IniImageNode::v_len
+	                The length of the string #IniImageNode::value
+	@property   IniImageNode::at_len
+	                The length of the string #IniImageNode::append_to
+
+
+
 	@struct     IniDispatch
 
 	@property   IniDispatch::format
@@ -345,6 +375,26 @@
 		/*  HEADERS  */
 
 #include <stdlib.h>
+#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#ifdef CONFINI_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef CONFINI_WITH_ZSTD
+#include <zstd.h>
+#endif
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define _CONFINI_HAS_SSE2_
+#endif
 #include "confini.h"
 
 
@@ -388,6 +438,21 @@
 	_CONFINI_CURRENT_FLAVOR_GET_(FT_FN)(FILEPTR)
 #define _CONFINI_OFF_T_ \
 	_CONFINI_CURRENT_FLAVOR_GET_(FT_T)
+#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
+/*  The nanoseconds of the modification time in a `struct stat`, if available  */
+#if defined(__APPLE__) && defined(_DARWIN_C_SOURCE)
+#define _CONFINI_MTIME_NSEC_(STAT) ((long int) (STAT).st_mtimespec.tv_nsec)
+#elif defined(__APPLE__)
+#define _CONFINI_MTIME_NSEC_(STAT) ((long int) (STAT).st_mtimensec)
+#elif defined(_POSIX_VERSION) && _POSIX_VERSION >= 200809L
+#define _CONFINI_MTIME_NSEC_(STAT) ((long int) (STAT).st_mtim.tv_nsec)
+#else
+#define _CONFINI_MTIME_NSEC_(STAT) 0L
+#endif
+#endif
+#if defined(CONFINI_WITH_ZLIB) || defined(CONFINI_WITH_ZSTD)
+#define _CONFINI_DECOMPRESS_
+#endif
 
 
 
@@ -411,6 +476,15 @@
 		/*  FUNCTIONAL MACROS AND CONSTANTS  */
 
 
+/*
+
+	The following macros are not table-driven like #is_some_space(): only five
+	characters can be markers, quotes or escapes, and the first comparison of each
+	chain rejects all the others without reading the format
+
+*/
+
+
 /*
 
 	Check whether a character can be escaped within a given format
@@ -513,6 +587,55 @@
 	(CHR > 0x40 && CHR < 0x5b ? CHR | 0x60 : CHR)
 
 
+/*
+
+	Ask the compiler to inline every function called by a function (used for the
+	format-specialized parsers -- see `CONFINI_SPECIALIZED_FORMATS`)
+
+*/
+#ifdef __GNUC__
+#define _CONFINI_FLATTEN_ __attribute__((__flatten__))
+#else
+#define _CONFINI_FLATTEN_
+#endif
+
+
+/*
+
+	Invoke a macro for each argument of a list of up to eight arguments
+
+*/
+#define _CONFINI_FOR_EACH_1_(MACRO, ARG) MACRO(ARG)
+#define _CONFINI_FOR_EACH_2_(MACRO, ARG, ...) \
+	MACRO(ARG) _CONFINI_FOR_EACH_1_(MACRO, __VA_ARGS__)
+#define _CONFINI_FOR_EACH_3_(MACRO, ARG, ...) \
+	MACRO(ARG) _CONFINI_FOR_EACH_2_(MACRO, __VA_ARGS__)
+#define _CONFINI_FOR_EACH_4_(MACRO, ARG, ...) \
+	MACRO(ARG) _CONFINI_FOR_EACH_3_(MACRO, __VA_ARGS__)
+#define _CONFINI_FOR_EACH_5_(MACRO, ARG, ...) \
+	MACRO(ARG) _CONFINI_FOR_EACH_4_(MACRO, __VA_ARGS__)
+#define _CONFINI_FOR_EACH_6_(MACRO, ARG, ...) \
+	MACRO(ARG) _CONFINI_FOR_EACH_5_(MACRO, __VA_ARGS__)
+#define _CONFINI_FOR_EACH_7_(MACRO, ARG, ...) \
+	MACRO(ARG) _CONFINI_FOR_EACH_6_(MACRO, __VA_ARGS__)
+#define _CONFINI_FOR_EACH_8_(MACRO, ARG, ...) \
+	MACRO(ARG) _CONFINI_FOR_EACH_7_(MACRO, __VA_ARGS__)
+#define _CONFINI_NINTH_ARG_(A1, A2, A3, A4, A5, A6, A7, A8, A9, ...) A9
+#define _CONFINI_FOR_EACH_(MACRO, ...) \
+	_CONFINI_NINTH_ARG_( \
+		__VA_ARGS__, \
+		_CONFINI_FOR_EACH_8_, \
+		_CONFINI_FOR_EACH_7_, \
+		_CONFINI_FOR_EACH_6_, \
+		_CONFINI_FOR_EACH_5_, \
+		_CONFINI_FOR_EACH_4_, \
+		_CONFINI_FOR_EACH_3_, \
+		_CONFINI_FOR_EACH_2_, \
+		_CONFINI_FOR_EACH_1_, \
+		_CONFINI_FOR_EACH_1_ \
+	)(MACRO, __VA_ARGS__)
+
+
 /*
 
 	Constants related to `_CONFINI_SPACES_`
@@ -539,15 +662,54 @@ static const char _CONFINI_SPACES_[_CONFINI_SPALEN_] = {
 
 /*
 
-	Possible depths of `_CONFINI_SPACES_` (see function #is_some_space()).
+	Classes of the characters listed in `_CONFINI_SPACES_` (see
+	`_CONFINI_CHR_CLASSES_`)
+
+*/
+#define _CONFINI_EOL_CLASS_ 1
+#define _CONFINI_VT_FF_CLASS_ 2
+#define _CONFINI_S_T_CLASS_ 4
+
+
+/*
+
+	Possible depths of `_CONFINI_SPACES_` (see function #is_some_space()), as masks
+	of the classes above.
 
 	Please, consider the following three constants as belonging together to a
 	virtual opaque `enum`.
 
 */
-#define _CONFINI_WITH_EOL_ -1
-#define _CONFINI_NO_EOL_ 1
-#define _CONFINI_JUST_S_T_ 3
+#define _CONFINI_WITH_EOL_ \
+	(_CONFINI_EOL_CLASS_ | _CONFINI_VT_FF_CLASS_ | _CONFINI_S_T_CLASS_)
+#define _CONFINI_NO_EOL_ (_CONFINI_VT_FF_CLASS_ | _CONFINI_S_T_CLASS_)
+#define _CONFINI_JUST_S_T_ _CONFINI_S_T_CLASS_
+
+
+/*
+
+	The class of each possible character, so that #is_some_space() can classify a
+	character with a single look-up -- keep it in sync with `_CONFINI_SPACES_`!
+
+*/
+static const uint_least8_t _CONFINI_CHR_CLASSES_[256] = {
+	[(unsigned char) _CONFINI_LF_] = _CONFINI_EOL_CLASS_,
+	[(unsigned char) _CONFINI_CR_] = _CONFINI_EOL_CLASS_,
+	[(unsigned char) _CONFINI_VT_] = _CONFINI_VT_FF_CLASS_,
+	[(unsigned char) _CONFINI_FF_] = _CONFINI_VT_FF_CLASS_,
+	[(unsigned char) _CONFINI_HT_] = _CONFINI_S_T_CLASS_,
+	[(unsigned char) _CONFINI_SIMPLE_SPACE_] = _CONFINI_S_T_CLASS_
+};
+
+
+/*
+
+	Possible results of #normalize_dispatch() for a node that must be dispatched
+	(zero means that the node must be skipped)
+
+*/
+#define _CONFINI_NORMALIZED_ 1
+#define _CONFINI_RAW_VALUE_ 2
 
 
 /**
@@ -596,9 +758,7 @@ static inline _CONFINI_CHARBOOL_ is_some_space (
 	const char chr,
 	const int_least8_t depth
 ) {
-	register int_least8_t idx = depth;
-	while (++idx < _CONFINI_SPALEN_ && chr != _CONFINI_SPACES_[idx]);
-	return idx < _CONFINI_SPALEN_;
+	return (_CONFINI_CHR_CLASSES_[(unsigned char) chr] & depth) != 0;
 }
 
 
@@ -806,7 +966,7 @@ static inline void string_tolower (
 	                                escape sequences)
 	@param          offs            The offset where to start the left trim
 	@param          format          The format of the INI file
-	@return         The offset of the first non-trivial character
+	@return         The offset where #further_cuts() must begin
 
 **/
 static inline size_t qultrim_h (
@@ -817,77 +977,75 @@ static inline size_t qultrim_h (
 
 	/*
 
-	Mask `abcd` (8 bits used):
-
-		FLAG_1      Single quotes are not metacharacters (const)
-		FLAG_2      Double quotes are not metacharacters (const)
-		FLAG_4      Unescaped single quotes are odd right now
-		FLAG_8      Unescaped double quotes are odd right now
-		FLAG_16     We are in an odd sequence of backslashes
-		FLAG_32     Erase the previous character
-		FLAG_64     Erase this character
-		FLAG_128    Continue the loop
+	Only a prefix can be erased: as soon as a character that is not part of the
+	pattern is found -- including a backslash that is not immediately followed by
+	a line break, or a quote that is not immediately followed by its twin -- the
+	loop stops there, so that the node is never split by the `NUL` characters
+	left behind.
 
 	*/
 
-	register uint_least8_t abcd =
-		(format.no_double_quotes ? 130 : 128) | format.no_single_quotes;
+	register size_t idx = offs;
 
-	size_t idx = offs;
+	for (;;) {
 
-	do {
+		if (is_some_space(srcstr[idx], _CONFINI_WITH_EOL_)) {
 
-		abcd =
+			srcstr[idx++] = '\0';
 
-			!(abcd & 28) && is_some_space(srcstr[idx], _CONFINI_NO_EOL_) ?
-				(abcd & 223) | 64
-			: !(abcd & 12) && (
-				srcstr[idx] == _CONFINI_LF_ ||
-				srcstr[idx] == _CONFINI_CR_
-			) ?
-				(
-					abcd & 16 ?
-						(abcd & 239) | 96
-					:
-						abcd | 64
-				)
-			: !(abcd & 22) && srcstr[idx] == _CONFINI_D_QUOTES_ ?
-				(
-					abcd & 8 ?
-						(abcd & 231) | 96
-					:
-						(abcd & 159) | 8
-				)
-			: !(abcd & 25) && srcstr[idx] == _CONFINI_S_QUOTES_ ?
-				(
-					abcd & 4 ?
-						(abcd & 235) | 96
-					:
-						(abcd & 159) | 4
-				)
-			: srcstr[idx] == _CONFINI_BACKSLASH_ ?
-				(abcd & 159) ^ 16
+		} else if (
+			srcstr[idx] == _CONFINI_BACKSLASH_ ? (
+				srcstr[idx + 1] == _CONFINI_LF_ ||
+				srcstr[idx + 1] == _CONFINI_CR_
+			) : srcstr[idx] == _CONFINI_D_QUOTES_ ?
+				!format.no_double_quotes && srcstr[idx + 1] == _CONFINI_D_QUOTES_
 			:
-				abcd & 31;
+				srcstr[idx] == _CONFINI_S_QUOTES_ &&
+				!format.no_single_quotes &&
+				srcstr[idx + 1] == _CONFINI_S_QUOTES_
+		) {
 
+			srcstr[idx++] = '\0';
+			srcstr[idx++] = '\0';
 
-		if (abcd & 32) {
+		} else {
 
-			srcstr[idx - 1] = '\0';
+			break;
 
 		}
 
-		if (abcd & 64) {
+	}
 
-			srcstr[idx] = '\0';
+	/*
 
-		}
+	#further_cuts() never examines the first character of an active node, so the
+	escaped backslashes that begin a node are skipped in pairs, in order not to
+	alter the parity of those that follow. If they are followed by a space, a
+	comment marker or nothing at all, the last backslash is returned instead, so
+	that the node is still counted as an active one.
 
-		idx++;
+	*/
 
-	} while (abcd & 128);
+	const size_t node_at = idx;
 
-	return abcd & 28 ? idx - 2 : idx - 1;
+	while (
+		srcstr[idx] == _CONFINI_BACKSLASH_ &&
+		srcstr[idx + 1] == _CONFINI_BACKSLASH_
+	) {
+
+		idx += 2;
+
+	}
+
+	return
+		idx > node_at && (
+			!srcstr[idx] ||
+			is_some_space(srcstr[idx], _CONFINI_WITH_EOL_) ||
+			_CONFINI_IS_ANY_MARKER_(srcstr[idx], format)
+		) ?
+			idx - 1
+		:
+			idx;
 
 }
 
@@ -976,6 +1134,120 @@ static inline size_t dqultrim_s (
 }
 
 
+/**
+
+	@brief          Find a character in a buffer, as `memchr()` would do
+	@param          str             The buffer to scan
+	@param          chr             The character to search
+	@param          idx             The offset where to start
+	@param          len             The length of @p str
+	@return         The offset of the first occurrence of @p chr, or @p len if
+	                there is none
+
+	The buffer is examined as in #skip_plain_chars().
+
+**/
+static inline size_t find_char (
+	const char * const str,
+	const char chr,
+	size_t idx,
+	const size_t len
+) {
+
+	#ifdef _CONFINI_HAS_SSE2_
+
+	const __m128i chr_vec = _mm_set1_epi8(chr);
+
+	for (; idx + 16 <= len; idx += 16) {
+
+		const int mask = _mm_movemask_epi8(
+			_mm_cmpeq_epi8(
+				_mm_loadu_si128((const __m128i *) (str + idx)),
+				chr_vec
+			)
+		);
+
+		if (mask) {
+
+			return idx + (size_t) __builtin_ctz((unsigned int) mask);
+
+		}
+
+	}
+
+	#else
+
+	#define __ONES__ ((uint_least64_t) 0x0101010101010101)
+	#define __HIGHS__ ((uint_least64_t) 0x8080808080808080)
+	#define __HAS_ZERO__(WORD) (((WORD) - __ONES__) & ~(WORD) & __HIGHS__)
+
+	for (; idx + 8 <= len; idx += 8) {
+
+		register uint_least64_t word = 0;
+
+		for (uint_least8_t shift = 0; shift < 64; shift += 8) {
+
+			word |=
+				(uint_least64_t) *((const unsigned char *) str + idx + shift / 8)
+				<< shift;
+
+		}
+
+		if (__HAS_ZERO__(word ^ (__ONES__ * (unsigned char) chr))) {
+
+			break;
+
+		}
+
+	}
+
+	#undef __HAS_ZERO__
+	#undef __HIGHS__
+	#undef __ONES__
+
+	#endif
+
+	while (idx < len && str[idx] != chr) {
+
+		idx++;
+
+	}
+
+	return idx;
+
+}
+
+
+/**
+
+	@brief          Find the first of two characters in a string, as `strpbrk()`
+	                would do
+	@param          str             The string to scan
+	@param          idx             The offset where to start
+	@param          chr_a           The first character to search, or `NUL`
+	@param          chr_b           The second character to search, or `NUL`
+	@return         The offset of the first occurrence of @p chr_a or @p chr_b, or
+	                the offset of the `NUL` terminator if there is none
+
+**/
+static inline size_t find_either_char (
+	const char * const str,
+	size_t idx,
+	const char chr_a,
+	const char chr_b
+) {
+
+	while (str[idx] && str[idx] != chr_a && str[idx] != chr_b) {
+
+		idx++;
+
+	}
+
+	return idx;
+
+}
+
+
 /**
 
 	@brief          Get the position of the first occurrence out of quotes of a
@@ -997,6 +1269,26 @@ static inline size_t getn_metachar_pos (
 
 	size_t idx = 0;
 
+	if (INIFORMAT_HAS_NO_ESC(format)) {
+
+		/*  There are no quotes to skip: a plain search is enough  */
+
+		if (chr) {
+
+			return find_char(str, chr, 0, len);
+
+		}
+
+		while (idx < len && !is_some_space(str[idx], _CONFINI_WITH_EOL_)) {
+
+			idx++;
+
+		}
+
+		return idx;
+
+	}
+
 	/*
 
 	Mask `abcd` (5 bits used):
@@ -1056,6 +1348,26 @@ static inline size_t get_metachar_pos (
 
 	size_t idx = 0;
 
+	if (INIFORMAT_HAS_NO_ESC(format)) {
+
+		/*  There are no quotes to skip: a plain search is enough  */
+
+		if (chr) {
+
+			return find_either_char(str, 0, chr, chr);
+
+		}
+
+		while (str[idx] && !is_some_space(str[idx], _CONFINI_NO_EOL_)) {
+
+			idx++;
+
+		}
+
+		return idx;
+
+	}
+
 	/*
 
 	Mask `abcd` (5 bits used):
@@ -1092,6 +1404,115 @@ static inline size_t get_metachar_pos (
 }
 
 
+/**
+
+	@brief          Skip a run of characters that do not need any attention from
+	                the first part of #strip_ini_cache()
+	@param          str             The buffer to scan
+	@param          idx             The offset where to start
+	@param          len             The length of @p str
+	@return         The offset of the first line feed, carriage return, backslash
+	                or `NUL` character found, or @p len if there is none
+
+	The buffer is examined sixteen bytes at a time when SSE2 is available, and
+	eight bytes at a time otherwise. The eight-byte words are assembled byte by
+	byte, so that alignment and byte order do not matter (compilers turn this
+	into a single load anyway).
+
+**/
+static inline size_t skip_plain_chars (
+	const char * const str,
+	size_t idx,
+	const size_t len
+) {
+
+	#ifdef _CONFINI_HAS_SSE2_
+
+	const __m128i
+		lf_vec = _mm_set1_epi8(_CONFINI_LF_),
+		cr_vec = _mm_set1_epi8(_CONFINI_CR_),
+		bs_vec = _mm_set1_epi8(_CONFINI_BACKSLASH_),
+		nul_vec = _mm_setzero_si128();
+
+	for (; idx + 16 <= len; idx += 16) {
+
+		const __m128i chunk = _mm_loadu_si128((const __m128i *) (str + idx));
+
+		const int mask = _mm_movemask_epi8(
+			_mm_or_si128(
+				_mm_or_si128(
+					_mm_cmpeq_epi8(chunk, lf_vec),
+					_mm_cmpeq_epi8(chunk, cr_vec)
+				),
+				_mm_or_si128(
+					_mm_cmpeq_epi8(chunk, bs_vec),
+					_mm_cmpeq_epi8(chunk, nul_vec)
+				)
+			)
+		);
+
+		if (mask) {
+
+			return idx + (size_t) __builtin_ctz((unsigned int) mask);
+
+		}
+
+	}
+
+	#else
+
+	#define __ONES__ ((uint_least64_t) 0x0101010101010101)
+	#define __HIGHS__ ((uint_least64_t) 0x8080808080808080)
+	#define __HAS_ZERO__(WORD) (((WORD) - __ONES__) & ~(WORD) & __HIGHS__)
+
+	for (; idx + 8 <= len; idx += 8) {
+
+		register uint_least64_t word = 0;
+
+		for (uint_least8_t shift = 0; shift < 64; shift += 8) {
+
+			word |=
+				(uint_least64_t) *((const unsigned char *) str + idx + shift / 8)
+				<< shift;
+
+		}
+
+		if (
+			__HAS_ZERO__(word) ||
+			__HAS_ZERO__(word ^ (__ONES__ * _CONFINI_LF_)) ||
+			__HAS_ZERO__(word ^ (__ONES__ * _CONFINI_CR_)) ||
+			__HAS_ZERO__(word ^ (__ONES__ * _CONFINI_BACKSLASH_))
+		) {
+
+			break;
+
+		}
+
+	}
+
+	#undef __HAS_ZERO__
+	#undef __HIGHS__
+	#undef __ONES__
+
+	#endif
+
+	while (
+		idx < len &&
+		str[idx] != _CONFINI_LF_ &&
+		str[idx] != _CONFINI_CR_ &&
+		str[idx] != _CONFINI_BACKSLASH_ &&
+		str[idx]
+	) {
+
+		idx++;
+
+	}
+
+	return idx;
+
+}
+
+
 /**
 
 	@brief          Replace `/\\(\n\r?|\r\n?)[\t \v\f]*[#;]/` or `/\\(\n\r?|\r\n?)/`
@@ -1174,24 +1595,108 @@ static size_t unescape_cr_lf (
 
 /**
 
-	@brief          Sanitize a section path
+	@brief          Sanitize a section path in a format without escape sequences
 	@param          secpath         The section path
-	@param          format          The format of the INI file
 	@return         The new length of the string
 
-	Out of quotes, similar to ECMAScript
-	`secpath.replace(/\.*\s*$|(?:\s*(\.))+\s*|^\s+/g, "$1").replace(/\s+/g, " ")`
-
-	A section path can start with a dot (append), but cannot end with a dot. Spaces
-	surrounding dots will be removed. Fragments surrounded by single or double
-	quotes (if these are enabled) are prevented from changes.
+	Equivalent to #sanitize_section_path() when `INIFORMAT_HAS_NO_ESC(format)`
+	is `true`: there are no quotes to track, so each character is either a
+	space, a dot, or part of a name.
 
 **/
-static size_t sanitize_section_path (
-	char * const secpath,
+static size_t sanitize_section_path_no_esc (
+	char * const secpath
+) {
+
+	/*
+
+	Mask `abcd` (4 bits used):
+
+		FLAG_1      The previous character was a space
+		FLAG_2      The previous character was a dot
+		FLAG_4      Nothing but spaces has been found so far
+		FLAG_8      Path contains at least one name
+
+	*/
+
+	register uint_least8_t abcd = 4;
+	register size_t idx_s = 0, idx_d = 0;
+
+	for (; secpath[idx_s]; idx_s++) {
+
+		if (is_some_space(secpath[idx_s], _CONFINI_WITH_EOL_)) {
+
+			if (!(abcd & 7)) {
+
+				secpath[idx_d++] = _CONFINI_COLLAPSED_;
+				abcd |= 1;
+
+			}
+
+		} else if (secpath[idx_s] == _CONFINI_SUBSECTION_) {
+
+			/*  A dot replaces the space before it and absorbs other dots  */
+			if (abcd & 3) {
+
+				secpath[idx_d - 1] = _CONFINI_SUBSECTION_;
+
+			} else {
+
+				secpath[idx_d++] = _CONFINI_SUBSECTION_;
+
+			}
+
+			abcd = (abcd & 8) | 2;
+
+		} else {
+
+			secpath[idx_d++] = secpath[idx_s];
+			abcd = 8;
+
+		}
+
+	}
+
+	if (idx_d && (abcd & 8) && (abcd & 3)) {
+
+		/*  Remove the trailing space or dot  */
+		idx_d--;
+
+	}
+
+	for (idx_s = idx_d; secpath[idx_s]; secpath[idx_s++] = '\0');
+
+	return idx_d;
+
+}
+
+
+/**
+
+	@brief          Sanitize a section path
+	@param          secpath         The section path
+	@param          format          The format of the INI file
+	@return         The new length of the string
+
+	Out of quotes, similar to ECMAScript
+	`secpath.replace(/\.*\s*$|(?:\s*(\.))+\s*|^\s+/g, "$1").replace(/\s+/g, " ")`
+
+	A section path can start with a dot (append), but cannot end with a dot. Spaces
+	surrounding dots will be removed. Fragments surrounded by single or double
+	quotes (if these are enabled) are prevented from changes.
+
+**/
+static size_t sanitize_section_path (
+	char * const secpath,
 	const IniFormat format
 ) {
 
+	if (INIFORMAT_HAS_NO_ESC(format)) {
+
+		return sanitize_section_path_no_esc(secpath);
+
+	}
+
 	/*
 
 	Mask `abcd` (12 bits used):
@@ -1304,6 +1809,52 @@ static size_t sanitize_section_path (
 }
 
 
+/**
+
+	@brief          Similar to ECMAScript `ini_string.replace(/\s+/g, " ").trim()`
+	@param          ini_string      The string to collapse
+	@return         The new length of the string
+
+	Equivalent to #collapse_everything() when `INIFORMAT_HAS_NO_ESC(format)` is
+	`true`: there are neither quotes nor empty quotes to look after.
+
+**/
+static size_t collapse_everything_no_esc (
+	char * const ini_string
+) {
+
+	register size_t idx_s = 0, idx_d = 0;
+	_CONFINI_CHARBOOL_ after_space = _CONFINI_TRUE_;
+
+	for (; ini_string[idx_s]; idx_s++) {
+
+		if (!is_some_space(ini_string[idx_s], _CONFINI_WITH_EOL_)) {
+
+			ini_string[idx_d++] = ini_string[idx_s];
+			after_space = _CONFINI_FALSE_;
+
+		} else if (!after_space) {
+
+			ini_string[idx_d++] = _CONFINI_COLLAPSED_;
+			after_space = _CONFINI_TRUE_;
+
+		}
+
+	}
+
+	if (after_space && idx_d) {
+
+		idx_d--;
+
+	}
+
+	for (idx_s = idx_d; ini_string[idx_s]; ini_string[idx_s++] = '\0');
+
+	return idx_d;
+
+}
+
+
 /**
 
 	@brief          Out of quotes similar to ECMAScript
@@ -1321,6 +1872,12 @@ static size_t collapse_everything (
 	const IniFormat format
 ) {
 
+	if (INIFORMAT_HAS_NO_ESC(format)) {
+
+		return collapse_everything_no_esc(ini_string);
+
+	}
+
 	/*
 
 	Mask `abcd` (9 bits used):
@@ -1980,7 +2537,8 @@ static uint_least8_t get_type_as_active (
 
 			idx = urtrim_s(srcstr, idx);
 
-			do {
+			/*  The key name might be empty: do not read before `srcstr`  */
+			while (idx) {
 
 				if (is_some_space(srcstr[--idx], _CONFINI_WITH_EOL_)) {
 
@@ -1988,7 +2546,7 @@ static uint_least8_t get_type_as_active (
 
 				}
 
-			} while (idx);
+			}
 
 		}
 
@@ -1999,6 +2557,143 @@ static uint_least8_t get_type_as_active (
 }
 
 
+/**
+
+	@brief          Examine a segment of a format without escape sequences and
+	                check whether it contains more than just one node
+	@param          srcstr          Segment to examine
+	@param          format          The format of the INI file
+	@return         Number of entries found
+
+	Equivalent to #further_cuts() when `INIFORMAT_HAS_NO_ESC(format)` is `true`:
+	a segment is then a single line, which can contain at most one node followed
+	by one inline comment, and there are no quotes that could hide a comment
+	marker.
+
+**/
+static size_t further_cuts_no_esc (
+	char * const srcstr,
+	const IniFormat format
+) {
+
+	const char
+		hash = format.hash_marker != INI_IS_NOT_A_MARKER ? _CONFINI_HASH_ : '\0',
+		semicolon =
+			format.semicolon_marker != INI_IS_NOT_A_MARKER ?
+				_CONFINI_SEMICOLON_
+			:
+				'\0';
+
+	size_t idx, name_at, focus_at;
+
+	if (!*srcstr) {
+
+		return 0;
+
+	}
+
+	if (
+		_CONFINI_IS_DIS_MARKER_(*srcstr, format) && (
+			format.disabled_after_space ||
+			!is_some_space(srcstr[1], _CONFINI_NO_EOL_)
+		)
+	) {
+
+		/*
+
+			Possibly a disabled entry: a comment marker that follows a space, or
+			that opens its content, starts an inline comment
+
+		*/
+
+		name_at = ltrim_s(srcstr, 1, _CONFINI_NO_EOL_);
+		idx = find_either_char(srcstr, name_at, hash, semicolon);
+
+		while (
+			srcstr[idx] && idx > name_at &&
+			!is_some_space(srcstr[idx - 1], _CONFINI_NO_EOL_)
+		) {
+
+			idx = find_either_char(srcstr, idx + 1, hash, semicolon);
+
+		}
+
+		focus_at = dqultrim_s(srcstr, 0, format);
+
+		if (!srcstr[idx]) {
+
+			if (
+				srcstr[focus_at] && !get_type_as_active(
+					srcstr + focus_at,
+					idx - focus_at,
+					format.disabled_can_be_implicit,
+					format
+				)
+			) {
+
+				*srcstr = _CONFINI_BC_INT_MARKER_;
+
+			}
+
+			return 1;
+
+		}
+
+		if (
+			!get_type_as_active(
+				srcstr + focus_at,
+				idx - focus_at,
+				format.disabled_can_be_implicit,
+				format
+			)
+		) {
+
+			*srcstr = _CONFINI_BC_INT_MARKER_;
+			return 1;
+
+		}
+
+	} else if (_CONFINI_IS_ANY_MARKER_(*srcstr, format)) {
+
+		/*  A comment, which cannot be multi-line, or a block to ignore  */
+		return !_CONFINI_IS_IGN_MARKER_(*srcstr, format);
+
+	} else {
+
+		/*  Active node: a comment marker that follows a space starts a comment  */
+
+		idx = find_either_char(srcstr, 1, hash, semicolon);
+
+		while (srcstr[idx] && !is_some_space(srcstr[idx - 1], _CONFINI_NO_EOL_)) {
+
+			idx = find_either_char(srcstr, idx + 1, hash, semicolon);
+
+		}
+
+		if (!srcstr[idx]) {
+
+			return 1;
+
+		}
+
+	}
+
+	/*  Cut the inline comment  */
+
+	srcstr[idx - 1] = '\0';
+
+	if (_CONFINI_IS_IGN_MARKER_(srcstr[idx], format)) {
+
+		return 1;
+
+	}
+
+	srcstr[idx] = _CONFINI_IC_INT_MARKER_;
+	return 2;
+
+}
+
+
 /**
 
 	@brief          Examine a (single-/multi-line) segment and check whether
@@ -2014,6 +2709,12 @@ static size_t further_cuts (
 	const IniFormat format
 ) {
 
+	if (INIFORMAT_HAS_NO_ESC(format)) {
+
+		return further_cuts_no_esc(srcstr, format);
+
+	}
+
 	/*  Abandon hope all ye who enter here  */
 
 	/*
@@ -2521,828 +3222,9283 @@ static size_t further_cuts (
 
 }
 
-/** @startfnlist **/
 
+/**
 
+	@brief          Determine the type of a node that is about to be dispatched
+	@param          dsp             The dispatch to examine, whose
+	                                #IniDispatch::data and #IniDispatch::d_len
+	                                fields must be already set to the raw node
+	@return         Nothing
 
-		/*\
-		|*|
-		|*|     GLOBAL ENVIRONMENT
-		|*|    ________________________________
-		\*/
+	The #IniDispatch::type field is set, and in case of disabled entries
+	#IniDispatch::data and #IniDispatch::d_len are moved past the disabled entry
+	marker.
 
+**/
+static void set_dispatch_type (
+	IniDispatch * const dsp
+) {
 
+	if (
+		_CONFINI_IS_DIS_MARKER_(*dsp->data, dsp->format) && (
+			dsp->format.disabled_after_space ||
+			!is_some_space(dsp->data[1], _CONFINI_NO_EOL_)
+		)
+	) {
 
-		/*  LIBRARY'S MAIN FUNCTIONS  */
+		const size_t focus_at = dqultrim_s(dsp->data, 0, dsp->format);
 
+		dsp->type = get_type_as_active(
+			dsp->data + focus_at,
+			dsp->d_len - focus_at,
+			dsp->format.disabled_can_be_implicit,
+			dsp->format
+		);
 
-                                                   /** @utility{strip_ini_cache} **/
-/**
+		if (dsp->type) {
 
-	@brief          Parse and tokenize a buffer containing an INI file, then
-	                dispatch its content to a custom callback
-	@param          ini_source      The buffer containing the INI file to tokenize
-	@param          ini_length      The length of @p ini_source without counting the
-	                                NUL terminator (if any -- se below)
-	@param          format          The format of the INI file
-	@param          f_init          The function that will be invoked before the
-	                                first dispatch, or `NULL`
-	@param          f_foreach       The function that will be invoked for each
-	                                dispatch, or `NULL`
-	@param          user_data       A custom argument, or `NULL`
-	@return         Zero for success, otherwise an error code (see `enum`
-	                #ConfiniInterruptNo)
+			dsp->data += focus_at;
+			dsp->d_len -= focus_at;
 
-	The @p ini_source parameter must be a valid pointer to a buffer of size
-	@p ini_length + 1 and cannot be `NULL`. The @p ini_source string does not need
-	to be NUL-terminated, but _it does need one extra byte where to append a NUL
-	terminator_ -- in fact, as soon as this function is invoked,
-	`ini_source[ini_length]` will be immediately set to `\0`.
+			/*
 
-	In most cases, as when using `strlen()` for computing @p ini_length, this is not
-	a concern, since `ini_source[ini_length]` will always be `\0` by the very
-	definition of `strlen()`, and will only get overwritten with the same value.
-	However, if you are passing a substring of a string, for example the fragment
-	`foo=bar` of the string `foo=barracuda`, you must expect the string to be
-	immediately truncated into `foo=bar\0acuda`.
+			// Not strictly needed...
+			for (size_t idx = focus_at; idx > 0; dsp->data[--idx] = '\0');
 
-	In other words, @p ini_source must point to a memory location where at least
-	`ini_length + 1` bytes are freely usable.
+			*/
 
-	The user given function @p f_init (see #IniStatsHandler data type) will be
-	invoked with two arguments: `statistics` (a pointer to an #IniStatistics
-	structure containing some properties about the file read) and `user_data` (the
-	custom argument @p user_data previously passed). If @p f_init returns a non-zero
-	value the caller function will be interrupted.
+		}
 
-	The user given function @p f_foreach (see #IniDispHandler data type) will be
-	invoked with two arguments: `dispatch` (a pointer to an #IniDispatch structure
-	containing the parsed member of the INI file) and `user_data` (the custom
-	argument @p user_data previously passed). If @p f_foreach returns a non-zero
-	value the caller function will be interrupted.
+		dsp->type |= INI_DISABLED_FLAG;
+		return;
 
-	After invoking `strip_ini_cache()`, the buffer pointed by the @p ini_source
-	parameter must be considered as a _corrupted buffer_ and should be freed or
-	overwritten. For more information about this function, please refer to the
-	@ref libconfini.
+	}
 
-	The parsing algorithms used by **libconfini** are able to parse any type of file
-	encoded in 8-bit code units, as long as the characters that match the regular
-	expression `/[\s\[\]\.\\;#"']/` refer to the same code points they refer to in
-	ASCII (as they do, for example, in UTF-8 and ISO-8859-1), independently of
-	platform-specific conventions.
+	switch (*dsp->data) {
 
-	@note   In order to be null-byte-injection-safe, before dispatching the parsed
-	        content this function strips all `NUL` characters possibly present in
-	        the buffer (with the exception of the last one).
-
-	Possible return values are: #CONFINI_SUCCESS, #CONFINI_IINTR, #CONFINI_FEINTR,
-	#CONFINI_EOOR.
-
-	@include topics/strip_ini_cache.c
-
-**/
-int strip_ini_cache (
-	register char * const ini_source,
-	const size_t ini_length,
-	const IniFormat format,
-	const IniStatsHandler f_init,
-	const IniDispHandler f_foreach,
-	void * const user_data
-) {
-
-	const _CONFINI_CHARBOOL_ valid_delimiter =
-		!_CONFINI_IS_ESC_CHAR_(format.delimiter_symbol, format);
+		default:
 
-	_CONFINI_CHARBOOL_ tmp_bool;
-	register size_t idx, tmp_fast_size_t_1, tmp_fast_size_t_2;
-	size_t tmp_size_t_1, tmp_size_t_2;
+			if (!_CONFINI_IS_ANY_MARKER_(*dsp->data, dsp->format)) {
 
-	ini_source[ini_length] = '\0';
+				dsp->type = get_type_as_active(
+					dsp->data,
+					dsp->d_len,
+					_CONFINI_TRUE_,
+					dsp->format
+				);
 
-	/*
+				break;
 
-		PART ONE: Examine and isolate each segment
+			}
 
-	*/
+			/*
 
-	#define __ISNT_ESCAPED__ tmp_bool
-	#define __LSHIFT__ tmp_fast_size_t_1
-	#define __EOL_N__ tmp_fast_size_t_2
-	#define __NL_AT__ tmp_size_t_1
-	#define __N_MEMBERS__ tmp_size_t_2
+				No case break here, keep it like this!
+				`case _CONFINI_BC_INT_MARKER_` must follow -- switch case
+				fallthrough
 
-	/*  UTF-8 BOM  */
-	__LSHIFT__ =
-		*((unsigned char *) ini_source) == 0xEF &&
-		*((unsigned char *) ini_source + 1) == 0xBB &&
-		*((unsigned char *) ini_source + 2) == 0xBF
-		? 3 : 0;
+			*/
 
-	for (
+		/* fallthrough */
+		case _CONFINI_BC_INT_MARKER_:
 
-		__N_MEMBERS__ = 0,
-		__EOL_N__ = _CONFINI_EOL_IDX_,
-		__ISNT_ESCAPED__ = _CONFINI_TRUE_,
-		__NL_AT__ = 0,
-		idx = __LSHIFT__;
+			/*
 
-			idx < ini_length;
+			// Not strictly needed...
+			*dsp->data = '\0';
 
-		idx++
+			*/
 
-	) {
+			dsp->type = INI_COMMENT;
+			break;
 
-		ini_source[idx - __LSHIFT__] = ini_source[idx];
+		case _CONFINI_IC_INT_MARKER_:
 
-		if (
-			ini_source[idx] == _CONFINI_SPACES_[__EOL_N__] ||
-			ini_source[idx] == _CONFINI_SPACES_[__EOL_N__ ^= 1]
-		) {
+			/*
 
-			if (format.multiline_nodes == INI_NO_MULTILINE || __ISNT_ESCAPED__) {
+			// Not strictly needed...
+			*dsp->data = '\0';
 
-				ini_source[idx - __LSHIFT__] = '\0';
-				__N_MEMBERS__ += further_cuts(
-					ini_source + qultrim_h(ini_source, __NL_AT__, format),
-					format
-				);
-				__NL_AT__ = idx - __LSHIFT__ + 1;
+			*/
 
-			} else if (ini_source[idx + 1] == _CONFINI_SPACES_[__EOL_N__ ^ 1]) {
+			dsp->type = INI_INLINE_COMMENT;
+			/*  No case break here (last case)  */
 
-				idx++;
-				ini_source[idx - __LSHIFT__] = ini_source[idx];
+	}
 
-			}
+}
 
-			__ISNT_ESCAPED__ = _CONFINI_TRUE_;
 
-		} else if (ini_source[idx] == _CONFINI_BACKSLASH_) {
+/**
 
-			__ISNT_ESCAPED__ = !__ISNT_ESCAPED__;
+	@brief          Check whether an INI string matches any of the simple strings
+	                of a list
+	@param          list            The list of simple strings
+	@param          list_len        The length of @p list
+	@param          ini_string      The INI string
+	@param          format          The format of the INI file
+	@return         A boolean: `true` if a match has been found, `false` otherwise
 
-		} else if (ini_source[idx]) {
+**/
+static _CONFINI_CHARBOOL_ is_in_list (
+	const char * const * const list,
+	const size_t list_len,
+	const char * const ini_string,
+	const IniFormat format
+) {
 
-			__ISNT_ESCAPED__ = _CONFINI_TRUE_;
+	for (size_t idx = 0; idx < list_len; idx++) {
 
-		} else {
+		if (ini_string_match_si(list[idx], ini_string, format)) {
 
-			/*  Remove `NUL` characters from the buffer (if any)  */
-			__LSHIFT__++;
+			return _CONFINI_TRUE_;
 
 		}
 
 	}
 
-	const size_t real_length = idx - __LSHIFT__;
-
-	while (idx > real_length) {
-
-		ini_source[--idx] = '\0';
+	return _CONFINI_FALSE_;
 
-	}
+}
 
-	__N_MEMBERS__ += further_cuts(
-		ini_source + qultrim_h(ini_source, __NL_AT__, format),
-		format
-	);
 
-	/*  Debug  */
+/**
 
-	/*
+	@brief          Normalize the value of a key
+	@param          dsp             The dispatch of the key, whose `value` and
+	                                `v_len` fields contain the raw value
+	@return         Nothing
 
-	for (size_t tmp = 0; tmp < ini_length + 1; tmp++) {
-		putchar(ini_source[tmp] == 0 ? '$' : ini_source[tmp]);
-	}
-	putchar('\n');
+**/
+static void normalize_value (
+	IniDispatch * const dsp
+) {
 
-	*/
+	const size_t raw_len = dsp->v_len;
+	size_t lshift;
 
-	IniStatistics this_doc = {
-		.format = format,
-		.bytes = ini_length,
-		.members = __N_MEMBERS__
-	};
+	dsp->v_len = 0;
 
-	if (f_init && f_init(&this_doc, user_data)) {
+	switch (
+		(dsp->format.preserve_empty_quotes << 1) |
+		dsp->format.do_not_collapse_values
+	) {
 
-		return CONFINI_IINTR;
+		case 0:	dsp->v_len = collapse_everything(dsp->value, dsp->format); break;
 
-	}
+		case 1:	dsp->v_len = collapse_empty_quotes(dsp->value, dsp->format); break;
 
-	#undef __N_MEMBERS__
-	#undef __NL_AT__
-	#undef __EOL_N__
-	#undef __LSHIFT__
-	#undef __ISNT_ESCAPED__
+		case 2:	dsp->v_len = collapse_spaces(dsp->value, dsp->format); break;
 
-	/*
+		case 4:
 
-		PART TWO: Dispatch the parsed input
+			lshift = ltrim_h(dsp->value, 0, _CONFINI_WITH_EOL_);
+			dsp->value += lshift;
+			dsp->v_len = rtrim_h(dsp->value, raw_len - lshift, _CONFINI_WITH_EOL_);
 
-	*/
+			/*  No case break here (last case)  */
 
-	if (!f_foreach) {
+	}
 
-		return CONFINI_SUCCESS;
+}
 
-	}
 
-	#define __NODE_AT__ tmp_fast_size_t_1
-	#define __CURR_PARENT_LEN__ tmp_fast_size_t_2
-	#define __SUBPARENT_LEN__ tmp_size_t_1
-	#define __REAL_PARENT_LEN__ tmp_size_t_2
-	#define __PARENT_IS_DISABLED__ tmp_bool
+/**
 
-	__REAL_PARENT_LEN__ = __CURR_PARENT_LEN__ = __SUBPARENT_LEN__  = 0;
+	@brief          Normalize the content of a node that is about to be dispatched
+	@param          dsp             The dispatch to normalize, whose type has been
+	                                already set by #set_dispatch_type()
+	@param          node_end        The NUL terminator of the raw node
+	@param          valid_delimiter Whether the delimiter of the format is not a
+	                                metacharacter
+	@param          interest        The keys that must be dispatched, or `NULL`
+	@param          options         The implicit value and the lowercase mode, or
+	                                `NULL` for using the global ones
+	@return         Zero if the node is a key that is not listed in @p interest,
+	                #_CONFINI_RAW_VALUE_ if the node is a key whose value has been
+	                left raw, #_CONFINI_NORMALIZED_ otherwise
+
+	Section paths are sanitized but keep their leading dot (if any): attaching a
+	section to its parent is a task of the caller. Comments are attached to an
+	empty path; all other nodes keep the #IniDispatch::append_to field untouched.
+
+	A key whose name is not listed in @p interest is left half-normalized: its
+	value is not even looked at. If @p interest asks for lazy values, the values
+	of the other keys are dispatched raw, and left to #normalize_value().
 
-	char
-		* curr_parent_str = ini_source + real_length,
-		* subparent_str = curr_parent_str,
-		* real_parent_str = curr_parent_str;
+**/
+static _CONFINI_CHARBOOL_ normalize_dispatch (
+	IniDispatch * const dsp,
+	char * const node_end,
+	const _CONFINI_CHARBOOL_ valid_delimiter,
+	const IniInterestSet * const interest,
+	const IniParseOptions * const options
+) {
 
-	IniDispatch dsp = {
-		.format = format,
-		.dispatch_id = 0
-	};
+	const _CONFINI_CHARBOOL_ lowercase_mode =
+		!dsp->format.case_sensitive && (
+			options ? options->lowercase_mode : INI_GLOBAL_LOWERCASE_MODE
+		);
 
-	__PARENT_IS_DISABLED__ = _CONFINI_FALSE_;
 
-	for (__NODE_AT__ = 0, idx = 0; idx <= real_length; idx++) {
+	_CONFINI_CHARBOOL_ result = _CONFINI_NORMALIZED_;
+	size_t idx;
 
-		if (ini_source[idx]) {
+	/*  Set `dsp->value` to an empty string  */
+	dsp->value = node_end;
+	dsp->v_len = 0;
 
-			continue;
+	if (dsp->type == INI_COMMENT || dsp->type == INI_INLINE_COMMENT) {
 
-		}
+		dsp->d_len = uncomment(++dsp->data, dsp->d_len - 1, dsp->format);
 
-		if (
-			!ini_source[__NODE_AT__] ||
-			_CONFINI_IS_IGN_MARKER_(ini_source[__NODE_AT__], format)
-		) {
+	} else if (dsp->format.multiline_nodes != INI_NO_MULTILINE) {
 
-			__NODE_AT__ = idx + 1;
-			continue;
+		dsp->d_len = unescape_cr_lf(
+			dsp->data,
+			dsp->d_len,
+			dsp->type & INI_DISABLED_FLAG,
+			dsp->format
+		);
 
-		}
+	}
 
-		if (dsp.dispatch_id >= this_doc.members) {
+	switch (dsp->type) {
 
-			return CONFINI_EOOR;
+		/*
 
-		}
+		case INI_UNKNOWN:
 
-		dsp.data = ini_source + __NODE_AT__;
-		dsp.d_len = idx - __NODE_AT__;
+			// Do nothing
 
-		/*  We won't need `__NODE_AT__` for a while, so let's recycle it...  */
-		#undef __NODE_AT__
-		#define __ITER__ tmp_fast_size_t_1
+			break;
 
-		/*  Set `dsp.value` to an empty string  */
-		dsp.value = ini_source + idx;
-		dsp.v_len = 0;
+		*/
 
-		if (
-			_CONFINI_IS_DIS_MARKER_(*dsp.data, format) && (
-				format.disabled_after_space ||
-				!is_some_space(dsp.data[1], _CONFINI_NO_EOL_)
-			)
-		) {
+		case INI_SECTION:
+		case INI_DISABLED_SECTION:
 
-			__ITER__ = dqultrim_s(dsp.data, 0, format);
+			*dsp->data++ = '\0';
 
-			dsp.type = get_type_as_active(
-				dsp.data + __ITER__,
-				dsp.d_len - __ITER__,
-				format.disabled_can_be_implicit,
-				format
+			idx = getn_metachar_pos(
+				dsp->data,
+				_CONFINI_CLOSE_SECTION_,
+				dsp->d_len,
+				dsp->format
 			);
 
-			if (dsp.type) {
+			while (dsp->data[idx]) {
 
-				dsp.data += __ITER__;
-				dsp.d_len -= __ITER__;
+				dsp->data[idx++] = '\0';
 
-				/*
+			}
 
-				// Not strictly needed...
-				for (; __ITER__ > 0; dsp.data[--__ITER__] = '\0');
+			dsp->d_len =
+				dsp->format.section_paths == INI_ONE_LEVEL_ONLY ?
+					collapse_everything(dsp->data, dsp->format)
+				:
+					sanitize_section_path(dsp->data, dsp->format);
 
-				*/
+			if (lowercase_mode) {
+
+				string_tolower(dsp->data);
 
 			}
 
-			dsp.type |= INI_DISABLED_FLAG;
+			break;
 
-		} else {
+		case INI_KEY:
+		case INI_DISABLED_KEY:
+
+			idx =
+				valid_delimiter ?
+					getn_metachar_pos(
+						dsp->data,
+						(char) dsp->format.delimiter_symbol,
+						dsp->d_len,
+						dsp->format
+					)
+				:
+					dsp->d_len;
 
-			switch (*dsp.data) {
+			if (idx < dsp->d_len) {
 
-				default:
+				dsp->data[idx] = '\0';
 
-					if (!_CONFINI_IS_ANY_MARKER_(*dsp.data, format)) {
+			}
 
-						dsp.type = get_type_as_active(
-							dsp.data,
-							dsp.d_len,
-							_CONFINI_TRUE_,
-							format
-						);
+			if (
+				interest && interest->n_keys &&
+				!is_in_list(interest->keys, interest->n_keys, dsp->data, dsp->format)
+			) {
 
-						break;
+				return _CONFINI_FALSE_;
 
-					}
+			}
 
-					/*
+			if (idx < dsp->d_len) {
 
-						No case break here, keep it like this!
-						`case _CONFINI_BC_INT_MARKER_` must follow -- switch case
-						fallthrough
+				dsp->value = dsp->data + idx + 1;
+				dsp->v_len = dsp->d_len + dsp->data - dsp->value;
 
-					*/
+				if (interest && interest->lazy_values) {
 
-				/* fallthrough */
-				case _CONFINI_BC_INT_MARKER_:
+					result = _CONFINI_RAW_VALUE_;
 
-					/*
+				} else {
 
-					// Not strictly needed...
-					*dsp.data = '\0';
+					normalize_value(dsp);
 
-					*/
+				}
 
-					dsp.type = INI_COMMENT;
-					break;
+			} else if (dsp->format.implicit_is_not_empty) {
 
-				case _CONFINI_IC_INT_MARKER_:
+				if (options) {
 
-					/*
+					dsp->value = options->implicit_value;
+					dsp->v_len = options->implicit_v_len;
 
-					// Not strictly needed...
-					*dsp.data = '\0';
+				} else {
 
-					*/
+					dsp->value = INI_GLOBAL_IMPLICIT_VALUE;
+					dsp->v_len = INI_GLOBAL_IMPLICIT_V_LEN;
 
-					dsp.type = INI_INLINE_COMMENT;
-					/*  No case break here (last case)  */
+				}
 
 			}
 
-		}
+			dsp->d_len = collapse_everything(dsp->data, dsp->format);
 
-		if (__CURR_PARENT_LEN__ && __SUBPARENT_LEN__) {
+			if (lowercase_mode) {
 
-			__ITER__ = 0;
+				string_tolower(dsp->data);
 
-			do {
+			}
 
-				curr_parent_str[__CURR_PARENT_LEN__ + __ITER__] =
-					subparent_str[__ITER__];
+			break;
 
-			} while (__ITER__++ < __SUBPARENT_LEN__);
+		case INI_COMMENT:
+		case INI_INLINE_COMMENT:
 
-			__CURR_PARENT_LEN__ += __SUBPARENT_LEN__;
-			subparent_str = curr_parent_str + __CURR_PARENT_LEN__;
-			__SUBPARENT_LEN__ = 0;
+			dsp->append_to = node_end;
+			dsp->at_len = 0;
+			/*  No case break here (last case)  */
 
-		}
+	}
 
-		if (__PARENT_IS_DISABLED__ && !(dsp.type & INI_DISABLED_FLAG)) {
+	return result;
 
-			real_parent_str[__REAL_PARENT_LEN__] = '\0';
-			__CURR_PARENT_LEN__ = __REAL_PARENT_LEN__;
-			curr_parent_str = real_parent_str;
-			__PARENT_IS_DISABLED__ = _CONFINI_FALSE_;
+}
 
-		} else if (!__PARENT_IS_DISABLED__ && dsp.type == INI_DISABLED_SECTION) {
 
-			__REAL_PARENT_LEN__ = __CURR_PARENT_LEN__;
-			real_parent_str = curr_parent_str;
-			__PARENT_IS_DISABLED__ = _CONFINI_TRUE_;
 
-		}
+/*
 
-		dsp.append_to = curr_parent_str;
-		dsp.at_len = __CURR_PARENT_LEN__;
+	Initial size of the buffers that must grow while reading from non-seekable
+	sources (the size is doubled each time the buffer gets full)
 
-		if (dsp.type == INI_COMMENT || dsp.type == INI_INLINE_COMMENT) {
+*/
+#define _CONFINI_GROWING_BUFSIZE_ 4096
 
-			dsp.d_len = uncomment(++dsp.data, dsp.d_len - 1, format);
 
-		} else if (format.multiline_nodes != INI_NO_MULTILINE) {
+#ifdef _CONFINI_DECOMPRESS_
 
-			dsp.d_len = unescape_cr_lf(
-				dsp.data,
-				dsp.d_len,
-				dsp.type & INI_DISABLED_FLAG,
-				format
-			);
+/*  Size of the chunks in which compressed files are read  */
+#define _CONFINI_COMPRESSED_CHUNK_ 65536
 
-		}
+/*  Compression formats recognized by their magic numbers  */
+#define _CONFINI_GZIP_ 1
+#define _CONFINI_ZSTD_ 2
 
-		switch (dsp.type) {
+/*  Highest compression ratio that DEFLATE can achieve  */
+#define _CONFINI_DEFLATE_MAX_RATIO_ 1032
 
-			/*
+#endif
 
-			case INI_UNKNOWN:
 
-				// Do nothing
+/**
 
-				break;
+	@brief          Make sure that a load buffer is at least @p min_size bytes
+	                large
+	@param          buffer          The buffer to check
+	@param          min_size        The minimum size required
+	@return         Zero for success, otherwise #CONFINI_ENOMEM
 
-			*/
+	The content of the buffer is not preserved when the buffer grows. On failure
+	the buffer is left empty.
 
-			case INI_SECTION:
-			case INI_DISABLED_SECTION:
+**/
+static int reserve_load_buffer (
+	IniLoadBuffer * const buffer,
+	const size_t min_size
+) {
 
-				*dsp.data++ = '\0';
+	if (buffer->size >= min_size) {
 
-				__ITER__ = getn_metachar_pos(
-					dsp.data,
-					_CONFINI_CLOSE_SECTION_,
-					dsp.d_len,
-					format
-				);
+		return CONFINI_SUCCESS;
 
-				while (dsp.data[__ITER__]) {
+	}
 
-					dsp.data[__ITER__++] = '\0';
+	/*  The old content is useless: `free()` + `malloc()` spares a copy  */
+	free(buffer->cache);
 
-				}
+	if (!(buffer->cache = (char *) malloc(min_size))) {
 
-				dsp.d_len =
-					format.section_paths == INI_ONE_LEVEL_ONLY ?
-						collapse_everything(dsp.data, format)
-					:
-						sanitize_section_path(dsp.data, format);
+		buffer->size = 0;
+		return CONFINI_ENOMEM;
 
-				if (
-					format.section_paths == INI_ONE_LEVEL_ONLY ||
-					*dsp.data != _CONFINI_SUBSECTION_
-				) {
+	}
 
-					/*
+	buffer->size = min_size;
+	return CONFINI_SUCCESS;
 
-						Append to root (this is an absolute path)
+}
 
-					*/
 
-					curr_parent_str = dsp.data;
-					__CURR_PARENT_LEN__ = dsp.d_len;
-					subparent_str = ini_source + idx;
-					__SUBPARENT_LEN__ = 0;
-					dsp.append_to = subparent_str;
-					dsp.at_len = 0;
+/**
 
-				} else if (
-					format.section_paths == INI_ABSOLUTE_ONLY ||
-					!__CURR_PARENT_LEN__
-				) {
+	@brief          Double the size of a load buffer, preserving its content
+	@param          buffer          The buffer to expand
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
 
-					/*
+	On failure @p buffer is left untouched.
 
-						Append to root and remove the leading dot (parent is root or
-						relative paths are not allowed)
+**/
+static int expand_load_buffer (
+	IniLoadBuffer * const buffer
+) {
 
-					*/
+	if (buffer->size > SIZE_MAX >> 1) {
 
-					curr_parent_str = ++dsp.data;
-					__CURR_PARENT_LEN__ = --dsp.d_len;
-					subparent_str = ini_source + idx;
-					__SUBPARENT_LEN__ = 0;
-					dsp.append_to = subparent_str;
-					dsp.at_len = 0;
+		return CONFINI_EFBIG;
 
-				} else if (dsp.d_len != 1) {
+	}
 
-					/*
+	char * const new_cache = (char *) realloc(buffer->cache, buffer->size << 1);
 
-						Append to the current parent (this is a relative path
-						and parent is not root)
+	if (!new_cache) {
 
-					*/
+		return CONFINI_ENOMEM;
 
-					subparent_str = dsp.data;
-					__SUBPARENT_LEN__ = dsp.d_len;
+	}
 
-				}
+	buffer->cache = new_cache;
+	buffer->size <<= 1;
+	return CONFINI_SUCCESS;
 
-				if (INI_GLOBAL_LOWERCASE_MODE && !format.case_sensitive) {
+}
 
-					string_tolower(dsp.data);
 
-				}
+/**
 
-				break;
+	@brief          Read a non-seekable stream until its end, using a buffer that
+	                grows geometrically
+	@param          ini_file        The `FILE` handle to read
+	@param          buffer          The buffer where to store the data read
+	@param          len_ptr         The address where to store the length of the
+	                                data read (the buffer is always at least one
+	                                byte larger than this)
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
 
-			case INI_KEY:
-			case INI_DISABLED_KEY:
+	On failure @p buffer is left in a consistent state and still needs to be
+	freed.
 
-				if (
-					valid_delimiter &&
-					(__ITER__ = getn_metachar_pos(
-						dsp.data,
-						(char) dsp.format.delimiter_symbol,
-						dsp.d_len,
-						format
-					)) < dsp.d_len
-				) {
+**/
+static int read_growing_stream (
+	FILE * const ini_file,
+	IniLoadBuffer * const buffer,
+	size_t * const len_ptr
+) {
 
-					dsp.data[__ITER__] = '\0';
-					dsp.value = dsp.data + __ITER__ + 1;
+	size_t cache_len = 0;
+	int io_err;
 
-					switch (
-						(format.preserve_empty_quotes << 1) |
-						format.do_not_collapse_values
-					) {
+	if (reserve_load_buffer(buffer, _CONFINI_GROWING_BUFSIZE_)) {
 
-						case 0:	dsp.v_len = collapse_everything(dsp.value, format); break;
+		return CONFINI_ENOMEM;
 
-						case 1:	dsp.v_len = collapse_empty_quotes(dsp.value, format); break;
+	}
 
-						case 2:	dsp.v_len = collapse_spaces(dsp.value, format); break;
+	/*  `fread()` returns less than requested only on end-of-file or error  */
+	while (
+		(cache_len += fread(
+			buffer->cache + cache_len,
+			1,
+			buffer->size - cache_len - 1,
+			ini_file
+		)) == buffer->size - 1
+	) {
 
-						case 4:
+		if ((io_err = expand_load_buffer(buffer))) {
 
-							dsp.value += ltrim_h(dsp.value, 0, _CONFINI_WITH_EOL_);
+			return io_err;
 
-							dsp.v_len = rtrim_h(
-								dsp.value,
-								dsp.d_len + dsp.data - dsp.value,
-								_CONFINI_WITH_EOL_
-							);
+		}
 
-							/*  No case break here (last case)  */
+	}
 
-					}
+	if (ferror(ini_file)) {
 
-				} else if (format.implicit_is_not_empty) {
+		return CONFINI_EIO;
 
-					dsp.value = INI_GLOBAL_IMPLICIT_VALUE;
-					dsp.v_len = INI_GLOBAL_IMPLICIT_V_LEN;
+	}
 
-				}
+	*len_ptr = cache_len;
+	return CONFINI_SUCCESS;
 
-				dsp.d_len = collapse_everything(dsp.data, format);
+}
 
-				if (INI_GLOBAL_LOWERCASE_MODE && !format.case_sensitive) {
 
-					string_tolower(dsp.data);
+#ifdef _CONFINI_DECOMPRESS_
 
-				}
+/**
 
-				break;
+	@brief          A compressed file being read in chunks
 
-			case INI_COMMENT:
-			case INI_INLINE_COMMENT:
+**/
+struct compressed_source {
+	FILE * file;
+	#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
+	int fd;
+	off_t offset;
+	#endif
+	size_t size;
+};
 
-				dsp.append_to = ini_source + idx;
-				dsp.at_len = 0;
-				/*  No case break here (last case)  */
 
-		}
+/**
 
-		if (f_foreach(&dsp, user_data)) {
+	@brief          Recognize the compression format of a file by its magic
+	                number
+	@param          magic           The first bytes of the file
+	@param          magic_len       The number of bytes in @p magic
+	@return         #_CONFINI_GZIP_, #_CONFINI_ZSTD_, or zero if the file is not
+	                compressed (or its format is not supported)
 
-			return CONFINI_FEINTR;
+**/
+static int get_compression_format (
+	const unsigned char * const magic,
+	const size_t magic_len
+) {
 
-		}
+	#ifdef CONFINI_WITH_ZLIB
 
-		dsp.dispatch_id++;
+	if (magic_len > 1 && magic[0] == 0x1F && magic[1] == 0x8B) {
 
-		/*  Restore `__NODE_AT__` on **exactly** the same variable as before  */
-		#undef __ITER__
-		#define __NODE_AT__ tmp_fast_size_t_1
-		__NODE_AT__ = idx + 1;
+		return _CONFINI_GZIP_;
 
 	}
 
-	#undef __PARENT_IS_DISABLED__
-	#undef __REAL_PARENT_LEN__
-	#undef __SUBPARENT_LEN__
-	#undef __CURR_PARENT_LEN__
-	#undef __NODE_AT__
+	#endif
 
-	return CONFINI_SUCCESS;
+	#ifdef CONFINI_WITH_ZSTD
+
+	if (
+		magic_len > 3 && magic[0] == 0x28 && magic[1] == 0xB5 &&
+		magic[2] == 0x2F && magic[3] == 0xFD
+	) {
+
+		return _CONFINI_ZSTD_;
+
+	}
+
+	#endif
+
+	(void) magic;
+	(void) magic_len;
+
+	return 0;
 
 }
 
 
-                                                     /** @utility{load_ini_file} **/
 /**
 
-	@brief          Parse an INI file and dispatch its content to a custom callback
-	                using a `FILE` structure as argument
-	@param          ini_file        The `FILE` handle pointing to the INI file to
-	                                parse
-	@param          format          The format of the INI file
-	@param          f_init          The function that will be invoked before the
-	                                first dispatch, or `NULL`
-	@param          f_foreach       The function that will be invoked for each
-	                                dispatch, or `NULL`
-	@param          user_data       A custom argument, or `NULL`
+	@brief          Read the next chunk of a compressed file
+	@param          source          The compressed file
+	@param          dest            The buffer where to store the chunk
+	@param          max_len         The size of @p dest
+	@param          len_ptr         The address where to store the length of the
+	                                chunk (zero on end-of-file)
 	@return         Zero for success, otherwise an error code (see `enum`
 	                #ConfiniInterruptNo)
 
-	@note   This function is absent if the `--without-io-api` option was passed to
-	        the `configure` script when the library was compiled
+**/
+static int read_compressed_chunk (
+	struct compressed_source * const source,
+	unsigned char * const dest,
+	const size_t max_len,
+	size_t * const len_ptr
+) {
 
-	The @p ini_file parameter must be a `FILE` handle with read privileges. On some
-	platforms, such as Microsoft Windows, it might be necessary to add the binary
-	specifier to the mode string (`"b"`) in order to prevent discrepancies between
-	the physical size of the file and its computed size. Adding the binary specifier
-	guarantees portability across all platforms:
+	#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
 
-	~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
-	FILE * my_file = fopen("example.conf", "rb");
-	~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	if (!source->file) {
 
-	For the two parameters @p f_init and @p f_foreach see function
-	#strip_ini_cache().
+		ssize_t chunk_len;
 
-	The parsing algorithms used by **libconfini** are able to parse any type of file
-	encoded in 8-bit code units, as long as the characters that match the regular
-	expression `/[\s\[\]\.\\;#"']/` refer to the same code points they refer to in
-	ASCII (as they do, for example, in UTF-8 and ISO-8859-1), independently of
-	platform-specific conventions.
+		while (
+			(chunk_len = pread(source->fd, dest, max_len, source->offset)) < 0
+		) {
 
-	@note   In order to be null-byte-injection safe, `NUL` characters, if present in
-	        the file, will be removed from the dispatched strings.
+			if (errno != EINTR) {
 
-	Possible return values are: #CONFINI_SUCCESS, #CONFINI_IINTR, #CONFINI_FEINTR,
-	#CONFINI_ENOMEM, #CONFINI_EIO, #CONFINI_EOOR, #CONFINI_EBADF, #CONFINI_EFBIG.
+				return CONFINI_EIO;
 
-	@include topics/load_ini_file.c
+			}
+
+		}
+
+		source->offset += chunk_len;
+		*len_ptr = (size_t) chunk_len;
+		return CONFINI_SUCCESS;
+
+	}
+
+	#endif
+
+	*len_ptr = fread(dest, 1, max_len, source->file);
+	return ferror(source->file) ? CONFINI_EIO : CONFINI_SUCCESS;
+
+}
+
+
+#ifdef CONFINI_WITH_ZLIB
+
+/**
+
+	@brief          Guess the decompressed size of a gzip file from its trailer
+	@param          source          The compressed file (its position must be at
+	                                the beginning and will be left there)
+	@return         The size of the uncompressed data, or zero if unknown
+
+	The trailer stores the size modulo 2^32 of the last member only, so the value
+	returned is just a hint.
 
 **/
-int load_ini_file (
-	FILE * const ini_file,
-	const IniFormat format,
-	const IniStatsHandler f_init,
-	const IniDispHandler f_foreach,
-	void * const user_data
+static size_t get_gzip_size_hint (
+	struct compressed_source * const source
 ) {
 
-	_CONFINI_OFF_T_ file_size;
-
-	if (
-		_CONFINI_SEEK_EOF_(ini_file) ||
-		(file_size = _CONFINI_FTELL_(ini_file)) < 0
-	) {
+	/*  Header (10 bytes) + empty deflate stream (2 bytes) + trailer (8 bytes)  */
+	if (source->size < 20) {
 
-		return CONFINI_EBADF;
+		return 0;
 
 	}
 
-	if ((uintmax_t) file_size > SIZE_MAX) {
+	unsigned char trailer[4];
+	size_t trailer_len;
 
-		return CONFINI_EFBIG;
+	#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
 
-	}
+	if (!source->file) {
 
-	char * const cache = (char *) malloc((size_t) file_size + 1);
+		const ssize_t read_len = pread(
+			source->fd,
+			trailer,
+			4,
+			(off_t) (source->size - 4)
+		);
 
-	if (!cache) {
+		trailer_len = read_len < 0 ? 0 : (size_t) read_len;
 
-		return CONFINI_ENOMEM;
+	} else
 
-	}
+	#endif
 
-	rewind(ini_file);
+	if (fseek(source->file, -4L, SEEK_END)) {
 
-	if (fread(cache, 1, (size_t) file_size, ini_file) < (size_t) file_size) {
+		trailer_len = 0;
 
-		free(cache);
-		return CONFINI_EIO;
+	} else {
+
+		trailer_len = fread(trailer, 1, 4, source->file);
+		rewind(source->file);
 
 	}
 
-	const int return_value = strip_ini_cache(
-		cache,
-		(size_t) file_size,
-		format,
-		f_init,
-		f_foreach,
-		user_data
-	);
+	if (trailer_len < 4) {
 
-	free(cache);
-	return return_value;
+		return 0;
+
+	}
+
+	const size_t isize =
+		(size_t) trailer[0] | (size_t) trailer[1] << 8 |
+		(size_t) trailer[2] << 16 | (size_t) trailer[3] << 24;
+
+	/*  Do not trust a size that no DEFLATE stream can produce  */
+	return
+		isize < SIZE_MAX && isize / _CONFINI_DEFLATE_MAX_RATIO_ <= source->size ?
+			isize
+		:
+			0;
 
 }
 
 
-                                                     /** @utility{load_ini_path} **/
 /**
 
-	@brief          Parse an INI file and dispatch its content to a custom callback
-	                using a path as argument
-	@param          path            The path of the INI file
-	@param          format          The format of the INI file
-	@param          f_init          The function that will be invoked before the
-	                                first dispatch, or `NULL`
-	@param          f_foreach       The function that will be invoked for each
-	                                dispatch, or `NULL`
-	@param          user_data       A custom argument, or `NULL`
+	@brief          Decompress a gzip file into a load buffer
+	@param          source          The compressed file
+	@param          chunk           A buffer of #_CONFINI_COMPRESSED_CHUNK_
+	                                bytes where to read the compressed data
+	@param          buffer          The buffer where to store the decompressed
+	                                data
+	@param          len_ptr         The address where to store the length of the
+	                                decompressed data (the buffer is always at
+	                                least one byte larger than this)
 	@return         Zero for success, otherwise an error code (see `enum`
 	                #ConfiniInterruptNo)
 
-	@note   This function is absent if the `--without-io-api` option was passed to
-	        the `configure` script when the library was compiled
+	Concatenated gzip members are decompressed one after the other, as `gzip -d`
+	does.
 
-	For the two parameters @p f_init and @p f_foreach see function
-	#strip_ini_cache().
+**/
+static int inflate_gzip (
+	struct compressed_source * const source,
+	unsigned char * const chunk,
+	IniLoadBuffer * const buffer,
+	size_t * const len_ptr
+) {
 
-	The parsing algorithms used by **libconfini** are able to parse any type of file
-	encoded in 8-bit code units, as long as the characters that match the regular
-	expression `/[\s\[\]\.\\;#"']/` refer to the same code points they refer to in
-	ASCII (as they do, for example, in UTF-8 and ISO-8859-1), independently of
-	platform-specific conventions.
+	const size_t size_hint = get_gzip_size_hint(source);
 
-	@note   In order to be null-byte-injection safe, `NUL` characters, if present in
-	        the file, will be removed from the dispatched strings.
+	if (
+		reserve_load_buffer(
+			buffer,
+			size_hint ? size_hint + 1 : _CONFINI_GROWING_BUFSIZE_
+		)
+	) {
 
-	Possible return values are: #CONFINI_SUCCESS, #CONFINI_IINTR, #CONFINI_FEINTR,
-	#CONFINI_ENOENT, #CONFINI_ENOMEM, #CONFINI_EIO, #CONFINI_EOOR, #CONFINI_EBADF,
-	#CONFINI_EFBIG.
+		return CONFINI_ENOMEM;
 
-	@include topics/load_ini_path.c
+	}
+
+	z_stream zstr;
+
+	zstr.zalloc = Z_NULL;
+	zstr.zfree = Z_NULL;
+	zstr.opaque = Z_NULL;
+	zstr.next_in = Z_NULL;
+	zstr.avail_in = 0;
+	zstr.avail_out = 0;
+
+	/*  `16 + MAX_WBITS` means "gzip wrapper"  */
+	if (inflateInit2(&zstr, 16 + MAX_WBITS) != Z_OK) {
+
+		return CONFINI_ENOMEM;
+
+	}
+
+	size_t cache_len = 0, chunk_len, out_len;
+	int z_ret = Z_OK, io_err;
+
+	for (;;) {
+
+		if (!zstr.avail_in) {
+
+			if ((io_err = read_compressed_chunk(
+				source,
+				chunk,
+				_CONFINI_COMPRESSED_CHUNK_,
+				&chunk_len
+			))) {
+
+				goto inflate_end;
+
+			}
+
+			/*  With no output space left, `inflate()` might have more to say  */
+			if (!chunk_len && (z_ret == Z_STREAM_END || zstr.avail_out)) {
+
+				break;
+
+			}
+
+			zstr.next_in = chunk;
+			zstr.avail_in = (uInt) chunk_len;
+
+		}
+
+		if (z_ret == Z_STREAM_END) {
+
+			/*  Another gzip member follows  */
+			inflateReset(&zstr);
+
+		}
+
+		if (
+			cache_len == buffer->size - 1 &&
+			(io_err = expand_load_buffer(buffer))
+		) {
+
+			goto inflate_end;
+
+		}
+
+		out_len = buffer->size - 1 - cache_len;
+		zstr.next_out = (Bytef *) buffer->cache + cache_len;
+		zstr.avail_out = out_len > (uInt) -1 ? (uInt) -1 : (uInt) out_len;
+		out_len = zstr.avail_out;
+		z_ret = inflate(&zstr, Z_NO_FLUSH);
+		cache_len += out_len - zstr.avail_out;
+
+		if (z_ret != Z_OK && z_ret != Z_STREAM_END && z_ret != Z_BUF_ERROR) {
+
+			io_err = z_ret == Z_MEM_ERROR ? CONFINI_ENOMEM : CONFINI_EIO;
+			goto inflate_end;
+
+		}
+
+	}
+
+	/*  A truncated file is an I/O error  */
+	io_err = z_ret == Z_STREAM_END ? CONFINI_SUCCESS : CONFINI_EIO;
+	*len_ptr = cache_len;
+
+
+	/* \                                /\
+	\ */     inflate_end:              /* \
+	 \/     ______________________     \ */
+
+
+	inflateEnd(&zstr);
+	return io_err;
+
+}
+
+#endif
+
+
+#ifdef CONFINI_WITH_ZSTD
+
+/**
+
+	@brief          Decompress a Zstandard file into a load buffer
+	@param          source          The compressed file
+	@param          chunk           A buffer of #_CONFINI_COMPRESSED_CHUNK_
+	                                bytes where to read the compressed data
+	@param          buffer          The buffer where to store the decompressed
+	                                data
+	@param          len_ptr         The address where to store the length of the
+	                                decompressed data (the buffer is always at
+	                                least one byte larger than this)
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	When the header of the first frame declares the size of its content the
+	buffer is allocated at once; concatenated frames are decompressed one after
+	the other, as `zstd -d` does.
 
 **/
-int load_ini_path (
-	const char * const path,
-	const IniFormat format,
-	const IniStatsHandler f_init,
-	const IniDispHandler f_foreach,
-	void * const user_data
+static int decompress_zstd (
+	struct compressed_source * const source,
+	unsigned char * const chunk,
+	IniLoadBuffer * const buffer,
+	size_t * const len_ptr
 ) {
 
-	FILE * const ini_file = fopen(path, "rb");
+	size_t chunk_len;
+	int io_err;
 
-	if (!ini_file) {
+	if ((io_err = read_compressed_chunk(
+		source,
+		chunk,
+		_CONFINI_COMPRESSED_CHUNK_,
+		&chunk_len
+	))) {
 
-		return CONFINI_ENOENT;
+		return io_err;
 
 	}
 
-	_CONFINI_OFF_T_ file_size;
+	if (!chunk_len) {
+
+		return CONFINI_EIO;
+
+	}
+
+	/*  `ZSTD_CONTENTSIZE_UNKNOWN` and `ZSTD_CONTENTSIZE_ERROR` are huge  */
+	const unsigned long long int size_hint =
+		ZSTD_getFrameContentSize(chunk, chunk_len);
 
 	if (
-		_CONFINI_SEEK_EOF_(ini_file) ||
-		(file_size = _CONFINI_FTELL_(ini_file)) < 0
+		reserve_load_buffer(
+			buffer,
+			size_hint < SIZE_MAX ?
+				(size_t) size_hint + 1
+			:
+				_CONFINI_GROWING_BUFSIZE_
+		)
 	) {
 
-		/*  No checks here, as there is nothing we can do about it...  */
-		fclose(ini_file);
-		return CONFINI_EBADF;
+		return CONFINI_ENOMEM;
 
 	}
 
-	if ((uintmax_t) file_size > SIZE_MAX) {
+	ZSTD_DCtx * const dctx = ZSTD_createDCtx();
 
-		/*  No checks here, as there is nothing we can do about it...  */
-		fclose(ini_file);
-		return CONFINI_EFBIG;
+	if (!dctx) {
+
+		return CONFINI_ENOMEM;
 
 	}
 
-	char * const cache = (char *) malloc((size_t) file_size + 1);
+	ZSTD_inBuffer zin = { chunk, chunk_len, 0 };
+	ZSTD_outBuffer zout = { (void *) 0, 0, 0 };
+	size_t cache_len = 0, z_ret = 1;
 
-	if (!cache) {
+	for (;;) {
 
-		/*  No checks here, as there is nothing we can do about it...  */
-		fclose(ini_file);
-		return CONFINI_ENOMEM;
+		if (zin.pos == zin.size) {
 
-	}
+			if ((io_err = read_compressed_chunk(
+				source,
+				chunk,
+				_CONFINI_COMPRESSED_CHUNK_,
+				&chunk_len
+			))) {
 
-	rewind(ini_file);
+				goto decompress_end;
 
-	if (fread(cache, 1, (size_t) file_size, ini_file) < (size_t) file_size) {
+			}
 
-		free(cache);
-		/*  No checks here, as there is nothing we can do about it...  */
-		fclose(ini_file);
-		return CONFINI_EIO;
+			/*  With no output space left, the decoder might have more to say  */
+			if (!chunk_len && (!z_ret || zout.pos < zout.size)) {
+
+				break;
+
+			}
+
+			zin.size = chunk_len;
+			zin.pos = 0;
+
+		}
+
+		if (
+			cache_len == buffer->size - 1 &&
+			(io_err = expand_load_buffer(buffer))
+		) {
+
+			goto decompress_end;
+
+		}
+
+		zout.dst = buffer->cache + cache_len;
+		zout.size = buffer->size - 1 - cache_len;
+		zout.pos = 0;
+		z_ret = ZSTD_decompressStream(dctx, &zout, &zin);
+
+		if (ZSTD_isError(z_ret)) {
+
+			io_err = CONFINI_EIO;
+			goto decompress_end;
+
+		}
+
+		cache_len += zout.pos;
 
 	}
 
-	/*  No checks here, as there is nothing we can do about it...  */
-	fclose(ini_file);
+	/*  A truncated file is an I/O error  */
+	io_err = z_ret ? CONFINI_EIO : CONFINI_SUCCESS;
+	*len_ptr = cache_len;
 
-	const int return_value = strip_ini_cache(
-		cache,
-		(size_t) file_size,
-		format,
-		f_init,
-		f_foreach,
-		user_data
-	);
 
-	free(cache);
-	return return_value;
+	/* \                                /\
+	\ */     decompress_end:           /* \
+	 \/     ______________________     \ */
+
+
+	ZSTD_freeDCtx(dctx);
+	return io_err;
+
+}
+
+#endif
+
+
+/**
+
+	@brief          Decompress a file into a load buffer
+	@param          source          The compressed file (positioned at its
+	                                beginning)
+	@param          format          The compression format, as returned by
+	                                #get_compression_format()
+	@param          buffer          The buffer where to store the decompressed
+	                                data
+	@param          len_ptr         The address where to store the length of the
+	                                decompressed data (the buffer is always at
+	                                least one byte larger than this)
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	The compressed data is read in chunks of #_CONFINI_COMPRESSED_CHUNK_ bytes
+	and decoded straight into @p buffer, so that the compressed file is never
+	held in memory as a whole.
+
+	On failure @p buffer is left in a consistent state and still needs to be
+	freed.
+
+**/
+static int read_compressed (
+	struct compressed_source * const source,
+	const int format,
+	IniLoadBuffer * const buffer,
+	size_t * const len_ptr
+) {
+
+	unsigned char * const chunk =
+		(unsigned char *) malloc(_CONFINI_COMPRESSED_CHUNK_);
+
+	if (!chunk) {
+
+		return CONFINI_ENOMEM;
+
+	}
+
+	int io_err;
+
+	switch (format) {
+
+		#ifdef CONFINI_WITH_ZLIB
+
+		case _CONFINI_GZIP_:
+
+			io_err = inflate_gzip(source, chunk, buffer, len_ptr);
+			break;
+
+		#endif
+
+		#ifdef CONFINI_WITH_ZSTD
+
+		case _CONFINI_ZSTD_:
+
+			io_err = decompress_zstd(source, chunk, buffer, len_ptr);
+			break;
+
+		#endif
+
+		default:
+
+			io_err = CONFINI_EIO;
+
+	}
+
+	free(chunk);
+	return io_err;
+
+}
+
+#endif
+
+
+/**
+
+	@brief          Read an INI file into a load buffer
+	@param          ini_file        The `FILE` handle to read
+	@param          buffer          The buffer where to store the data read
+	@param          len_ptr         The address where to store the length of the
+	                                data read (the buffer is always at least one
+	                                byte larger than this)
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	Seekable streams are read as a whole, independently of their current position;
+	non-seekable streams are read from their current position until end-of-file.
+	Seekable streams compressed in one of the formats enabled at build time are
+	decompressed on the fly.
+
+**/
+static int read_ini_file (
+	FILE * const ini_file,
+	IniLoadBuffer * const buffer,
+	size_t * const len_ptr
+) {
+
+	_CONFINI_OFF_T_ file_size;
+
+	if (
+		_CONFINI_SEEK_EOF_(ini_file) ||
+		(file_size = _CONFINI_FTELL_(ini_file)) < 0
+	) {
+
+		/*  Non-seekable stream (pipe, socket, terminal...)  */
+		return read_growing_stream(ini_file, buffer, len_ptr);
+
+	}
+
+	if ((uintmax_t) file_size >= SIZE_MAX) {
+
+		return CONFINI_EFBIG;
+
+	}
+
+	rewind(ini_file);
+
+	/*  Bytes already read while looking for a magic number  */
+	size_t magic_len = 0;
+
+	#ifdef _CONFINI_DECOMPRESS_
+
+	unsigned char magic[4];
+
+	magic_len = fread(magic, 1, file_size < 4 ? (size_t) file_size : 4, ini_file);
+
+	const int compression = get_compression_format(magic, magic_len);
+
+	if (compression) {
+
+		struct compressed_source source;
+
+		source.file = ini_file;
+		source.size = (size_t) file_size;
+		rewind(ini_file);
+
+		return read_compressed(&source, compression, buffer, len_ptr);
+
+	}
+
+	#endif
+
+	if (reserve_load_buffer(buffer, (size_t) file_size + 1)) {
+
+		return CONFINI_ENOMEM;
+
+	}
+
+	#ifdef _CONFINI_DECOMPRESS_
+
+	for (size_t idx = 0; idx < magic_len; idx++) {
+
+		buffer->cache[idx] = (char) magic[idx];
+
+	}
+
+	#endif
+
+	if (
+		fread(
+			buffer->cache + magic_len,
+			1,
+			(size_t) file_size - magic_len,
+			ini_file
+		) < (size_t) file_size - magic_len
+	) {
+
+		return CONFINI_EIO;
+
+	}
+
+	*len_ptr = (size_t) file_size;
+	return CONFINI_SUCCESS;
+
+}
+
+
+#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
+
+/**
+
+	@brief          Read a file descriptor until its end, using a buffer that grows
+	                geometrically
+	@param          ini_fd          The file descriptor to read
+	@param          buffer          The buffer where to store the data read
+	@param          len_ptr         The address where to store the length of the
+	                                data read (the buffer is always at least one
+	                                byte larger than this)
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	On failure @p buffer is left in a consistent state and still needs to be
+	freed.
+
+**/
+static int read_growing_fd (
+	const int ini_fd,
+	IniLoadBuffer * const buffer,
+	size_t * const len_ptr
+) {
+
+	size_t cache_len = 0;
+	int io_err;
+	ssize_t chunk_len;
+
+	if (reserve_load_buffer(buffer, _CONFINI_GROWING_BUFSIZE_)) {
+
+		return CONFINI_ENOMEM;
+
+	}
+
+	while (
+		(chunk_len = read(
+			ini_fd,
+			buffer->cache + cache_len,
+			buffer->size - cache_len - 1
+		))
+	) {
+
+		if (chunk_len < 0) {
+
+			if (errno == EINTR) {
+
+				continue;
+
+			}
+
+			return CONFINI_EIO;
+
+		}
+
+		if ((cache_len += (size_t) chunk_len) < buffer->size - 1) {
+
+			/*  Pipes and sockets may return less than requested  */
+			continue;
+
+		}
+
+		if ((io_err = expand_load_buffer(buffer))) {
+
+			return io_err;
+
+		}
+
+	}
+
+	*len_ptr = cache_len;
+	return CONFINI_SUCCESS;
+
+}
+
+
+/**
+
+	@brief          Read a file descriptor into a buffer, sizing the latter with a
+	                single `fstat()`
+	@param          ini_fd          The file descriptor to read
+	@param          buffer          The buffer where to store the data read
+	@param          len_ptr         The address where to store the length of the
+	                                data read (the buffer is always at least one
+	                                byte larger than this)
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	Regular files are read as a whole with `pread()`, independently of (and
+	without changing) the current offset of @p ini_fd; everything else -- and
+	regular files that declare a size of zero, like those under `/proc` -- is
+	read from the current offset until end-of-file.
+	Regular files compressed in one of the formats enabled at build time are
+	decompressed on the fly.
+
+	On failure @p buffer is left in a consistent state and still needs to be
+	freed.
+
+**/
+static int read_ini_fd (
+	const int ini_fd,
+	IniLoadBuffer * const buffer,
+	size_t * const len_ptr
+) {
+
+	struct stat file_stat;
+
+	if (
+		fstat(ini_fd, &file_stat) ||
+		!S_ISREG(file_stat.st_mode) ||
+		file_stat.st_size < 1
+	) {
+
+		return read_growing_fd(ini_fd, buffer, len_ptr);
+
+	}
+
+	if ((uintmax_t) file_stat.st_size >= SIZE_MAX) {
+
+		return CONFINI_EFBIG;
+
+	}
+
+	const size_t file_size = (size_t) file_stat.st_size;
+
+	#ifdef _CONFINI_DECOMPRESS_
+
+	unsigned char magic[4];
+	const ssize_t magic_len = pread(ini_fd, magic, 4, 0);
+
+	const int compression = magic_len > 0 ?
+		get_compression_format(magic, (size_t) magic_len)
+	:
+		0;
+
+	if (compression) {
+
+		struct compressed_source source;
+
+		source.file = (FILE *) 0;
+		source.fd = ini_fd;
+		source.offset = 0;
+		source.size = file_size;
+
+		return read_compressed(&source, compression, buffer, len_ptr);
+
+	}
+
+	#endif
+
+	if (reserve_load_buffer(buffer, file_size + 1)) {
+
+		return CONFINI_ENOMEM;
+
+	}
+
+	size_t cache_len = 0;
+	ssize_t chunk_len;
+
+	/*  If the file shrinks in the meanwhile, parse only what is left  */
+	while (
+		cache_len < file_size && (chunk_len = pread(
+			ini_fd,
+			buffer->cache + cache_len,
+			file_size - cache_len,
+			(off_t) cache_len
+		))
+	) {
+
+		if (chunk_len < 0) {
+
+			if (errno == EINTR) {
+
+				continue;
+
+			}
+
+			return CONFINI_EIO;
+
+		}
+
+		cache_len += (size_t) chunk_len;
+
+	}
+
+	*len_ptr = cache_len;
+	return CONFINI_SUCCESS;
+
+}
+
+
+/*
+
+	Size of the pool of threads that read the fragments of a directory, and
+	maximum number of fragments that can be read ahead of the one being
+	dispatched
+
+*/
+#define _CONFINI_DIR_WORKERS_ 4
+#define _CONFINI_DIR_READAHEAD_ 16
+
+
+/**
+
+	@brief  A fragment of a directory loaded by #load_ini_dir()
+
+**/
+struct dir_fragment {
+	char * name;
+	IniLoadBuffer buffer;
+	size_t len;
+	int status;
+	_CONFINI_CHARBOOL_ is_ready;
+};
+
+
+/**
+
+	@brief  The state shared between the dispatcher and the readers of
+	        #load_ini_dir()
+
+**/
+struct dir_reader {
+	struct dir_fragment * fragments;
+	size_t n_fragments;
+	size_t next_read;
+	size_t n_dispatched;
+	int dir_fd;
+	_CONFINI_CHARBOOL_ must_stop;
+	pthread_mutex_t lock;
+	pthread_cond_t change;
+};
+
+
+/**
+
+	@brief          Compare two fragments by name (`qsort()` callback)
+	@param          v_frag_a        The first fragment
+	@param          v_frag_b        The second fragment
+	@return         A negative number, zero or a positive number, as `strcmp()`
+	                does
+
+	Names are compared byte by byte, independently of the current locale.
+
+**/
+static int compare_dir_fragments (
+	const void * const v_frag_a,
+	const void * const v_frag_b
+) {
+
+	return strcmp(
+		((const struct dir_fragment *) v_frag_a)->name,
+		((const struct dir_fragment *) v_frag_b)->name
+	);
+
+}
+
+
+/**
+
+	@brief          Read a fragment of a directory into its own buffer
+	@param          dir_fd          The file descriptor of the directory
+	@param          fragment        The fragment to read
+	@return         Nothing (the result is stored in `fragment->status`)
+
+**/
+static void read_dir_fragment (
+	const int dir_fd,
+	struct dir_fragment * const fragment
+) {
+
+	const int ini_fd = openat(dir_fd, fragment->name, O_RDONLY);
+
+	if (ini_fd < 0) {
+
+		fragment->status = CONFINI_ENOENT;
+		return;
+
+	}
+
+	fragment->status = read_ini_fd(ini_fd, &fragment->buffer, &fragment->len);
+
+	/*  No checks here, as there is nothing we can do about it...  */
+	close(ini_fd);
+
+}
+
+
+/**
+
+	@brief          Body of the threads that read the fragments of a directory
+	@param          v_reader        The `struct dir_reader` shared with the
+	                                dispatcher
+	@return         Always `NULL`
+
+	Each thread picks the first fragment that nobody is reading yet, without ever
+	getting more than #_CONFINI_DIR_READAHEAD_ fragments ahead of the dispatcher.
+
+**/
+static void * read_dir_fragments (
+	void * const v_reader
+) {
+
+	struct dir_reader * const reader = (struct dir_reader *) v_reader;
+	size_t frag_num;
+
+	pthread_mutex_lock(&reader->lock);
+
+	for (;;) {
+
+		while (
+			!reader->must_stop &&
+			reader->next_read < reader->n_fragments &&
+			reader->next_read >= reader->n_dispatched + _CONFINI_DIR_READAHEAD_
+		) {
+
+			pthread_cond_wait(&reader->change, &reader->lock);
+
+		}
+
+		if (reader->must_stop || reader->next_read >= reader->n_fragments) {
+
+			break;
+
+		}
+
+		frag_num = reader->next_read++;
+		pthread_mutex_unlock(&reader->lock);
+		read_dir_fragment(reader->dir_fd, reader->fragments + frag_num);
+		pthread_mutex_lock(&reader->lock);
+		reader->fragments[frag_num].is_ready = _CONFINI_TRUE_;
+		pthread_cond_broadcast(&reader->change);
+
+	}
+
+	pthread_mutex_unlock(&reader->lock);
+	return (void *) 0;
+
+}
+
+#endif
+
+
+
+/*
+
+	Initial sizes of the buffers of a streaming parser (both buffers grow
+	geometrically when needed)
+
+*/
+#define _CONFINI_STREAM_SEGSIZE_ 1024
+#define _CONFINI_STREAM_PATHSIZE_ 64
+
+
+/**
+
+	@brief  The private state of a streaming parser
+
+	Only the segment (a single- or multi-line group of nodes) that is currently
+	being received and the current section path are kept in memory.
+
+	The @p path buffer contains the path of the current active parent at offset
+	zero. While a disabled section is the current parent and its path is not
+	relative to the active parent, this is stored immediately after the NUL
+	terminator of the latter, at offset @p real_len + 1, so that the active
+	parent can be restored as soon as an active node is found.
+
+**/
+struct IniStream {
+	IniFormat format;
+	IniDispHandler f_foreach;
+	void * user_data;
+	const IniParseOptions * options;
+	char * segment;
+	size_t seg_len;
+	size_t seg_size;
+	char * path;
+	size_t path_size;
+	size_t curr_at;
+	size_t curr_len;
+	size_t real_len;
+	size_t dispatch_id;
+	int status;
+	uint_least8_t bom_at;
+	_CONFINI_CHARBOOL_ eol_n;
+	_CONFINI_CHARBOOL_ isnt_escaped;
+	_CONFINI_CHARBOOL_ pair_is_pending;
+	_CONFINI_CHARBOOL_ parent_is_disabled;
+	_CONFINI_CHARBOOL_ valid_delimiter;
+};
+
+
+/**
+
+	@brief          Make sure that a growing buffer is at least @p min_size bytes
+	                large, preserving its content
+	@param          buf_ptr         The address of the buffer
+	@param          size_ptr        The address of the size of the buffer
+	@param          min_size        The minimum size required
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	The buffer is never shrunk; when it grows its size is at least doubled.
+
+**/
+static int grow_buffer (
+	char ** const buf_ptr,
+	size_t * const size_ptr,
+	const size_t min_size
+) {
+
+	if (*size_ptr >= min_size) {
+
+		return CONFINI_SUCCESS;
+
+	}
+
+	if (*size_ptr > SIZE_MAX >> 1) {
+
+		return CONFINI_EFBIG;
+
+	}
+
+	const size_t new_size =
+		min_size > *size_ptr << 1 ? min_size : *size_ptr << 1;
+
+	char * const new_buf = (char *) realloc(*buf_ptr, new_size);
+
+	if (!new_buf) {
+
+		return CONFINI_ENOMEM;
+
+	}
+
+	*buf_ptr = new_buf;
+	*size_ptr = new_size;
+	return CONFINI_SUCCESS;
+
+}
+
+
+/**
+
+	@brief          Bring a streaming parser back to the beginning of a file,
+	                keeping its buffers
+	@param          stream          The streaming parser
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         Nothing
+
+**/
+static void reset_stream (
+	IniStream * const stream,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	*stream->path = '\0';
+	stream->f_foreach = f_foreach;
+	stream->user_data = user_data;
+	stream->seg_len = 0;
+	stream->curr_at = 0;
+	stream->curr_len = 0;
+	stream->real_len = 0;
+	stream->dispatch_id = 0;
+	stream->status = CONFINI_SUCCESS;
+	stream->bom_at = 0;
+	stream->eol_n = _CONFINI_EOL_IDX_;
+	stream->isnt_escaped = _CONFINI_TRUE_;
+	stream->pair_is_pending = _CONFINI_FALSE_;
+	stream->parent_is_disabled = _CONFINI_FALSE_;
+
+}
+
+
+/**
+
+	@brief          Replace the current parent of a streaming parser
+	@param          stream          The streaming parser
+	@param          parent_str      The new parent
+	@param          parent_len      The length of @p parent_str
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+**/
+static int set_stream_parent (
+	IniStream * const stream,
+	const char * const parent_str,
+	const size_t parent_len
+) {
+
+	const size_t parent_at =
+		stream->parent_is_disabled ? stream->real_len + 1 : 0;
+
+	const int grow_err = grow_buffer(
+		&stream->path,
+		&stream->path_size,
+		parent_at + parent_len + 1
+	);
+
+	if (grow_err) {
+
+		return grow_err;
+
+	}
+
+	for (size_t idx = 0; idx < parent_len; idx++) {
+
+		stream->path[parent_at + idx] = parent_str[idx];
+
+	}
+
+	stream->path[parent_at + parent_len] = '\0';
+	stream->curr_at = parent_at;
+	stream->curr_len = parent_len;
+	return CONFINI_SUCCESS;
+
+}
+
+
+/**
+
+	@brief          Tokenize and dispatch the segment that a streaming parser has
+	                just received
+	@param          stream          The streaming parser
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	This function performs on a single segment the same work that
+	#strip_ini_cache() performs on a whole buffer. The section path is kept in the
+	private buffer of @p stream instead of being built in place.
+
+	If @p stream has no `f_foreach` callback the members of the segment are only
+	counted and added to `stream->dispatch_id`.
+
+**/
+static int flush_stream_segment (
+	IniStream * const stream
+) {
+
+	char * const segment = stream->segment;
+	const size_t seg_len = stream->seg_len;
+
+	stream->seg_len = 0;
+	segment[seg_len] = '\0';
+
+	size_t n_members = further_cuts(
+		segment + qultrim_h(segment, 0, stream->format),
+		stream->format
+	);
+
+	if (!stream->f_foreach) {
+
+		/*  Only count the members  */
+		stream->dispatch_id += n_members;
+		return CONFINI_SUCCESS;
+
+	}
+
+	IniDispatch dsp = {
+		.format = stream->format,
+		.dispatch_id = stream->dispatch_id
+	};
+
+	const char * subparent_str;
+	size_t subparent_len, node_at = 0;
+	int grow_err;
+
+	for (size_t idx = 0; idx <= seg_len; idx++) {
+
+		if (segment[idx]) {
+
+			continue;
+
+		}
+
+		if (
+			!segment[node_at] ||
+			_CONFINI_IS_IGN_MARKER_(segment[node_at], stream->format)
+		) {
+
+			node_at = idx + 1;
+			continue;
+
+		}
+
+		if (!n_members--) {
+
+			return CONFINI_EOOR;
+
+		}
+
+		dsp.data = segment + node_at;
+		dsp.d_len = idx - node_at;
+		set_dispatch_type(&dsp);
+
+		if (stream->parent_is_disabled && !(dsp.type & INI_DISABLED_FLAG)) {
+
+			stream->path[stream->real_len] = '\0';
+			stream->curr_at = 0;
+			stream->curr_len = stream->real_len;
+			stream->parent_is_disabled = _CONFINI_FALSE_;
+
+		} else if (
+			!stream->parent_is_disabled && dsp.type == INI_DISABLED_SECTION
+		) {
+
+			stream->real_len = stream->curr_len;
+			stream->parent_is_disabled = _CONFINI_TRUE_;
+
+		}
+
+		dsp.append_to = stream->path + stream->curr_at;
+		dsp.at_len = stream->curr_len;
+		normalize_dispatch(
+			&dsp,
+			segment + idx,
+			stream->valid_delimiter,
+			(const IniInterestSet *) 0,
+			stream->options
+		);
+		subparent_len = 0;
+
+		if ((dsp.type | INI_DISABLED_FLAG) == INI_DISABLED_SECTION) {
+
+			if (
+				stream->format.section_paths == INI_ONE_LEVEL_ONLY ||
+				*dsp.data != _CONFINI_SUBSECTION_
+			) {
+
+				/*
+
+					Append to root (this is an absolute path)
+
+				*/
+
+				if ((grow_err = set_stream_parent(stream, dsp.data, dsp.d_len))) {
+
+					return grow_err;
+
+				}
+
+				dsp.append_to = segment + idx;
+				dsp.at_len = 0;
+
+			} else if (
+				stream->format.section_paths == INI_ABSOLUTE_ONLY ||
+				!stream->curr_len
+			) {
+
+				/*
+
+					Append to root and remove the leading dot (parent is root or
+					relative paths are not allowed)
+
+				*/
+
+				if (
+					(grow_err = set_stream_parent(stream, ++dsp.data, --dsp.d_len))
+				) {
+
+					return grow_err;
+
+				}
+
+				dsp.append_to = segment + idx;
+				dsp.at_len = 0;
+
+			} else if (dsp.d_len != 1) {
+
+				/*
+
+					Append to the current parent (this is a relative path and
+					parent is not root) -- this will be done after the dispatch
+
+				*/
+
+				subparent_str = dsp.data;
+				subparent_len = dsp.d_len;
+
+			}
+
+		}
+
+		if (stream->f_foreach(&dsp, stream->user_data)) {
+
+			return CONFINI_FEINTR;
+
+		}
+
+		stream->dispatch_id = ++dsp.dispatch_id;
+
+		if (subparent_len) {
+
+			if (
+				(grow_err = grow_buffer(
+					&stream->path,
+					&stream->path_size,
+					stream->curr_at + stream->curr_len + subparent_len + 1
+				))
+			) {
+
+				return grow_err;
+
+			}
+
+			for (size_t iter = 0; iter < subparent_len; iter++) {
+
+				stream->path[stream->curr_at + stream->curr_len++] =
+					subparent_str[iter];
+
+			}
+
+			stream->path[stream->curr_at + stream->curr_len] = '\0';
+
+		}
+
+		node_at = idx + 1;
+
+	}
+
+	return CONFINI_SUCCESS;
+
+}
+
+
+
+
+
+/*  Magic number and version of the compiled images (see #ini_compile())  */
+#define _CONFINI_IMAGE_MAGIC_ "\177CONFINI"
+#define _CONFINI_IMAGE_VERSION_ 2
+
+/*  Written in the native byte order, so that foreign images are rejected  */
+#define _CONFINI_IMAGE_BYTE_ORDER_ 0x01020304
+
+/*  Offset of a `NULL` value  */
+#define _CONFINI_IMAGE_NO_VALUE_ 0xFFFFFFFF
+
+
+/**
+
+	@brief          Header of a compiled image
+
+	The header is followed by `n_nodes` `struct image_node` records, then by
+	`n_buckets` `uint32_t` heads of the hash chains (each one the index of a node
+	plus one, or zero), then by the NUL-terminated strings. All the offsets are
+	relative to `strings_at`, so that the image can be mapped at any address.
+
+	The header also records what else the dispatches depended on: the
+	effective lowercase mode, the implicit value (stored among the strings), and
+	the size and modification time of the INI file at compile time.
+
+**/
+struct IniImage {
+	char magic[8];
+	uint32_t byte_order;
+	uint32_t version;
+	uint32_t format;
+	uint32_t n_nodes;
+	uint32_t n_buckets;
+	uint32_t strings_at;
+	uint32_t image_size;
+	uint32_t lowercase_mode;
+	uint32_t implicit_offs;
+	uint32_t implicit_len;
+	uint32_t source_nsec;
+	uint32_t reserved;
+	uint64_t source_size;
+	int64_t source_mtime;
+};
+
+
+/**
+
+	@brief          A node of a compiled image
+
+**/
+struct image_node {
+	uint32_t at_offs;
+	uint32_t at_len;
+	uint32_t d_offs;
+	uint32_t d_len;
+	uint32_t v_offs;
+	uint32_t v_len;
+	uint32_t type;
+	uint32_t next;
+};
+
+
+/**
+
+	@brief          The state of #ini_compile() while it collects the nodes
+
+**/
+struct image_builder {
+	char * nodes;
+	char * strings;
+	size_t nodes_size;
+	size_t strings_size;
+	size_t n_nodes;
+	size_t strings_len;
+	uint32_t last_at_offs;
+	uint32_t last_at_len;
+	int status;
+};
+
+
+/**
+
+	@brief          Hash a section path and a key name together (FNV-1a)
+	@param          section         The section path
+	@param          section_len     The length of @p section
+	@param          key             The key name
+	@param          key_len         The length of @p key
+	@param          case_fold       Whether to ignore the case of the ASCII
+	                                letters
+	@return         The hash
+
+**/
+static uint32_t hash_image_key (
+	const char * const section,
+	const size_t section_len,
+	const char * const key,
+	const size_t key_len,
+	const _CONFINI_CHARBOOL_ case_fold
+) {
+
+	uint32_t hash = 2166136261U;
+	size_t idx;
+
+	for (idx = 0; idx < section_len; idx++) {
+
+		hash = (hash ^ (uint32_t) (unsigned char) (
+			case_fold ? _CONFINI_CHR_CASEFOLD_(section[idx]) : section[idx]
+		)) * 16777619U;
+
+	}
+
+	/*  Separate the section path from the key name  */
+	hash = (hash ^ 0xFFU) * 16777619U;
+
+	for (idx = 0; idx < key_len; idx++) {
+
+		hash = (hash ^ (uint32_t) (unsigned char) (
+			case_fold ? _CONFINI_CHR_CASEFOLD_(key[idx]) : key[idx]
+		)) * 16777619U;
+
+	}
+
+	return hash;
+
+}
+
+
+/**
+
+	@brief          Append a string to the string table of an image being
+	                compiled
+	@param          builder         The image being compiled
+	@param          str             The string to append
+	@param          len             The length of @p str
+	@param          offs_ptr        The address where to store the offset of the
+	                                string
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+**/
+static int add_image_string (
+	struct image_builder * const builder,
+	const char * const str,
+	const size_t len,
+	uint32_t * const offs_ptr
+) {
+
+	if (builder->strings_len + len >= _CONFINI_IMAGE_NO_VALUE_) {
+
+		return CONFINI_EFBIG;
+
+	}
+
+	const int grow_err = grow_buffer(
+		&builder->strings,
+		&builder->strings_size,
+		builder->strings_len + len + 1
+	);
+
+	if (grow_err) {
+
+		return grow_err;
+
+	}
+
+	for (size_t idx = 0; idx < len; idx++) {
+
+		builder->strings[builder->strings_len + idx] = str[idx];
+
+	}
+
+	builder->strings[builder->strings_len + len] = '\0';
+	*offs_ptr = (uint32_t) builder->strings_len;
+	builder->strings_len += len + 1;
+	return CONFINI_SUCCESS;
+
+}
+
+
+/**
+
+	@brief          Store a dispatch into an image being compiled
+	@param          dispatch        The dispatch to store
+	@param          v_builder       The image being compiled
+	@return         Zero for success, non-zero for failure (the error code is
+	                stored in `builder->status`)
+
+	Consecutive nodes that belong to the same section share the same copy of the
+	section path.
+
+**/
+static int compile_image_node (
+	IniDispatch * const dispatch,
+	void * const v_builder
+) {
+
+	#define builder ((struct image_builder *) v_builder)
+
+	if (builder->n_nodes >= _CONFINI_IMAGE_NO_VALUE_ >> 5) {
+
+		return (builder->status = CONFINI_EFBIG);
+
+	}
+
+	if (
+		(builder->status = grow_buffer(
+			&builder->nodes,
+			&builder->nodes_size,
+			(builder->n_nodes + 1) * sizeof(struct image_node)
+		))
+	) {
+
+		return builder->status;
+
+	}
+
+	struct image_node * const node =
+		(struct image_node *) builder->nodes + builder->n_nodes;
+
+	_CONFINI_CHARBOOL_ at_is_new = dispatch->at_len != builder->last_at_len;
+
+	for (size_t idx = 0; !at_is_new && idx < dispatch->at_len; idx++) {
+
+		at_is_new =
+			dispatch->append_to[idx] !=
+			builder->strings[builder->last_at_offs + idx];
+
+	}
+
+	if (
+		at_is_new && (builder->status = add_image_string(
+			builder,
+			dispatch->append_to,
+			dispatch->at_len,
+			&builder->last_at_offs
+		))
+	) {
+
+		return builder->status;
+
+	}
+
+	builder->last_at_len = (uint32_t) dispatch->at_len;
+	node->at_offs = builder->last_at_offs;
+	node->at_len = builder->last_at_len;
+	node->d_len = (uint32_t) dispatch->d_len;
+	node->v_len = (uint32_t) dispatch->v_len;
+	node->type = dispatch->type;
+	node->next = 0;
+
+	if (
+		(builder->status = add_image_string(
+			builder,
+			dispatch->data,
+			dispatch->d_len,
+			&node->d_offs
+		))
+	) {
+
+		return builder->status;
+
+	}
+
+	if (!dispatch->value) {
+
+		node->v_offs = _CONFINI_IMAGE_NO_VALUE_;
+		node->v_len = 0;
+
+	} else if (
+		(builder->status = add_image_string(
+			builder,
+			dispatch->value,
+			dispatch->v_len,
+			&node->v_offs
+		))
+	) {
+
+		return builder->status;
+
+	}
+
+	builder->n_nodes++;
+	return CONFINI_SUCCESS;
+
+	#undef builder
+
+}
+
+
+/**
+
+	@brief          Record the size and the modification time of an INI file in
+	                the header of an image
+	@param          ini_path        The path of the INI file
+	@param          dest            The header to fill
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	Without the POSIX I/O API there is no portable way to read the modification
+	time of a file, and only its size is recorded.
+
+**/
+static int stamp_image_source (
+	const char * const ini_path,
+	IniImage * const dest
+) {
+
+	#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
+
+	struct stat ini_stat;
+
+	if (stat(ini_path, &ini_stat)) {
+
+		return CONFINI_ENOENT;
+
+	}
+
+	dest->source_size = (uint64_t) ini_stat.st_size;
+	dest->source_mtime = (int64_t) ini_stat.st_mtime;
+	dest->source_nsec = (uint32_t) _CONFINI_MTIME_NSEC_(ini_stat);
+
+	#else
+
+	FILE * const ini_file = fopen(ini_path, "rb");
+
+	if (!ini_file) {
+
+		return CONFINI_ENOENT;
+
+	}
+
+	const long int ini_size =
+		fseek(ini_file, 0, SEEK_END) ? -1L : ftell(ini_file);
+
+	/*  No checks here, as there is nothing we can do about it...  */
+	fclose(ini_file);
+
+	if (ini_size < 0) {
+
+		return CONFINI_EIO;
+
+	}
+
+	dest->source_size = (uint64_t) ini_size;
+	dest->source_mtime = 0;
+	dest->source_nsec = 0;
+
+	#endif
+
+	return CONFINI_SUCCESS;
+
+}
+
+
+/**
+
+	@brief          Check whether a string of an image lies within its string
+	                table and is NUL-terminated
+	@param          strings         The string table of the image
+	@param          strings_len     The size of @p strings
+	@param          offs            The offset of the string
+	@param          len             The length of the string
+	@return         A boolean
+
+**/
+static _CONFINI_CHARBOOL_ image_string_is_valid (
+	const char * const strings,
+	const size_t strings_len,
+	const uint32_t offs,
+	const uint32_t len
+) {
+
+	return offs < strings_len && len < strings_len - offs && !strings[offs + len];
+
+}
+
+
+/**
+
+	@brief          Check whether a block of memory contains a valid image that
+	                matches the current configuration of the library
+	@param          image           The block of memory
+	@param          image_size      The size of @p image
+	@param          format          The format that the image must have
+	@param          ini_path        The INI file the image must have been
+	                                compiled from, or `NULL`
+	@return         A boolean
+
+	Besides the header, every node and every head of the hash chains are checked,
+	so that the strings never lie outside of the image and the hash chains always
+	end. If @p ini_path is not `NULL` its size and modification time must match
+	those recorded when the image was compiled.
+
+**/
+static _CONFINI_CHARBOOL_ image_is_valid (
+	const IniImage * const image,
+	const size_t image_size,
+	const IniFormat format,
+	const char * const ini_path
+) {
+
+	if (image_size < sizeof(IniImage)) {
+
+		return _CONFINI_FALSE_;
+
+	}
+
+	size_t idx;
+
+	for (idx = 0; idx < sizeof(image->magic); idx++) {
+
+		if (image->magic[idx] != _CONFINI_IMAGE_MAGIC_[idx]) {
+
+			return _CONFINI_FALSE_;
+
+		}
+
+	}
+
+	if (
+		image->byte_order != _CONFINI_IMAGE_BYTE_ORDER_ ||
+		image->version != _CONFINI_IMAGE_VERSION_ ||
+		image->format != ini_fton(format) ||
+		image->image_size != image_size ||
+		!image->n_buckets || (image->n_buckets & (image->n_buckets - 1)) ||
+		image->n_nodes >
+			(image_size - sizeof(IniImage)) / sizeof(struct image_node) ||
+		image->n_buckets > (
+			image_size - sizeof(IniImage) -
+			image->n_nodes * sizeof(struct image_node)
+		) / sizeof(uint32_t) ||
+		image->strings_at !=
+			sizeof(IniImage) + image->n_nodes * sizeof(struct image_node) +
+			image->n_buckets * sizeof(uint32_t) ||
+		image->lowercase_mode !=
+			(uint32_t) (!format.case_sensitive && INI_GLOBAL_LOWERCASE_MODE)
+	) {
+
+		return _CONFINI_FALSE_;
+
+	}
+
+	const char * const strings = (const char *) image + image->strings_at;
+	const size_t strings_len = image_size - image->strings_at;
+
+	/*  Implicit values are dispatched only when `implicit_is_not_empty` is set  */
+	const char * const implicit_value =
+		format.implicit_is_not_empty ? INI_GLOBAL_IMPLICIT_VALUE : (char *) 0;
+
+	if (!implicit_value) {
+
+		if (image->implicit_offs != _CONFINI_IMAGE_NO_VALUE_) {
+
+			return _CONFINI_FALSE_;
+
+		}
+
+	} else {
+
+		if (
+			image->implicit_offs >= strings_len ||
+			image->implicit_len != INI_GLOBAL_IMPLICIT_V_LEN
+		) {
+
+			return _CONFINI_FALSE_;
+
+		}
+
+		const char * const stored = strings + image->implicit_offs;
+		const size_t stored_size = strings_len - image->implicit_offs;
+
+		for (idx = 0; implicit_value[idx]; idx++) {
+
+			if (idx >= stored_size || stored[idx] != implicit_value[idx]) {
+
+				return _CONFINI_FALSE_;
+
+			}
+
+		}
+
+		if (idx >= stored_size || stored[idx]) {
+
+			return _CONFINI_FALSE_;
+
+		}
+
+	}
+
+	const struct image_node * const nodes =
+		(const struct image_node *) (image + 1);
+
+	for (idx = 0; idx < image->n_nodes; idx++) {
+
+		/*  The hash chains always point backwards, so they cannot loop  */
+		if (
+			nodes[idx].type > INI_DISABLED_SECTION ||
+			nodes[idx].next > idx ||
+			!image_string_is_valid(
+				strings,
+				strings_len,
+				nodes[idx].at_offs,
+				nodes[idx].at_len
+			) ||
+			!image_string_is_valid(
+				strings,
+				strings_len,
+				nodes[idx].d_offs,
+				nodes[idx].d_len
+			) || (
+				nodes[idx].v_offs != _CONFINI_IMAGE_NO_VALUE_ &&
+				!image_string_is_valid(
+					strings,
+					strings_len,
+					nodes[idx].v_offs,
+					nodes[idx].v_len
+				)
+			)
+		) {
+
+			return _CONFINI_FALSE_;
+
+		}
+
+	}
+
+	const uint32_t * const buckets = (const uint32_t *) (nodes + image->n_nodes);
+
+	for (idx = 0; idx < image->n_buckets; idx++) {
+
+		if (buckets[idx] > image->n_nodes) {
+
+			return _CONFINI_FALSE_;
+
+		}
+
+	}
+
+	if (!ini_path) {
+
+		return _CONFINI_TRUE_;
+
+	}
+
+	IniImage source;
+
+	return
+		!stamp_image_source(ini_path, &source) &&
+		source.source_size == image->source_size &&
+		source.source_mtime == image->source_mtime &&
+		source.source_nsec == image->source_nsec;
+
+}
+
+
+/**
+
+	@brief          Fill an #IniImageNode structure with a node of an image
+	@param          image           The image
+	@param          node            The node
+	@param          dest            The structure to fill
+	@return         Nothing
+
+**/
+static void get_image_node (
+	const IniImage * const image,
+	const struct image_node * const node,
+	IniImageNode * const dest
+) {
+
+	const char * const strings = (const char *) image + image->strings_at;
+
+	dest->type = (uint_least8_t) node->type;
+	dest->data = strings + node->d_offs;
+	dest->d_len = node->d_len;
+	dest->append_to = strings + node->at_offs;
+	dest->at_len = node->at_len;
+
+	if (node->v_offs == _CONFINI_IMAGE_NO_VALUE_) {
+
+		dest->value = (const char *) 0;
+		dest->v_len = 0;
+
+	} else {
+
+		dest->value = strings + node->v_offs;
+		dest->v_len = node->v_len;
+
+	}
+
+}
+
+
+#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
+
+/*  Value offset of the nodes whose value is #INI_GLOBAL_IMPLICIT_VALUE  */
+#define _CONFINI_CACHE_IMPLICIT_ 0xFFFFFFFE
+
+/*  Number of chains of the index of the parse cache (must be a power of two)  */
+#define _CONFINI_CACHE_BUCKETS_ 64
+
+/*
+
+	Access to the budget of the parse cache that does not need the lock, so that
+	#load_ini_path() can check whether the cache is enabled (the budget is still
+	written only while the cache is locked)
+
+*/
+#ifdef __GNUC__
+#define _CONFINI_ATOMIC_GET_(VAR) __atomic_load_n(&(VAR), __ATOMIC_RELAXED)
+#define _CONFINI_ATOMIC_SET_(VAR, VAL) \
+	__atomic_store_n(&(VAR), (VAL), __ATOMIC_RELAXED)
+#else
+#define _CONFINI_ATOMIC_GET_(VAR) (*((volatile size_t *) &(VAR)))
+#define _CONFINI_ATOMIC_SET_(VAR, VAL) \
+	(*((volatile size_t *) &(VAR)) = (VAL))
+#endif
+
+
+/**
+
+	@brief          A file stored in the parse cache (see #ini_cache_set_budget())
+
+	An entry is valid only as long as the file has the same device, inode,
+	modification time and size, and is parsed with the same format and the same
+	global settings. The implicit value is compared by content, so a private copy
+	of it is kept in the entry.
+
+	Besides the list sorted by use, each entry belongs to the chain of the index
+	selected by its device and inode number (see #hash_cache_key()).
+
+**/
+struct cache_entry {
+	struct cache_entry * prev;
+	struct cache_entry * next;
+	struct cache_entry * chain_prev;
+	struct cache_entry * chain_next;
+	char * nodes;
+	char * strings;
+	size_t n_nodes;
+	size_t strings_len;
+	size_t bytes;
+	size_t cost;
+	size_t n_users;
+	dev_t dev;
+	ino_t ino;
+	time_t mtime;
+	long int mtime_nsec;
+	off_t size;
+	IniFormatNum format;
+	char * implicit_value;
+	size_t implicit_v_len;
+	_CONFINI_CHARBOOL_ lowercase_mode;
+	_CONFINI_CHARBOOL_ is_evicted;
+};
+
+
+/**
+
+	@brief          The process-wide parse cache
+
+	The entries form a list sorted from the most recently to the least recently
+	used one, and are indexed by file in `chains`. Entries that are evicted while
+	they are being replayed are freed by the last thread that uses them.
+
+**/
+static struct {
+	pthread_mutex_t lock;
+	struct cache_entry * first;
+	struct cache_entry * last;
+	struct cache_entry * chains[_CONFINI_CACHE_BUCKETS_];
+	size_t budget;
+	size_t cost;
+} parse_cache = {
+	PTHREAD_MUTEX_INITIALIZER,
+	(struct cache_entry *) 0,
+	(struct cache_entry *) 0,
+	{ (struct cache_entry *) 0 },
+	0,
+	0
+};
+
+
+/**
+
+	@brief          A dispatch handler that stores each dispatch into a new cache
+	                entry before forwarding it to the user's handler
+
+**/
+struct cache_recorder {
+	struct image_builder builder;
+	IniStatsHandler f_init;
+	IniDispHandler f_foreach;
+	void * user_data;
+	size_t bytes;
+};
+
+
+/**
+
+	@brief          Free a cache entry
+	@param          entry           The entry to free
+	@return         Nothing
+
+**/
+static void free_cache_entry (
+	struct cache_entry * const entry
+) {
+
+	free(entry->implicit_value);
+	free(entry->strings);
+	free(entry->nodes);
+	free(entry);
+
+}
+
+
+/**
+
+	@brief          Get the chain of the parse cache where a file is indexed
+	@param          dev             The device of the file
+	@param          ino             The inode number of the file
+	@return         The address of the first entry of the chain
+
+**/
+static inline struct cache_entry ** hash_cache_key (
+	const dev_t dev,
+	const ino_t ino
+) {
+
+	register uintmax_t hash = (uintmax_t) ino ^ ((uintmax_t) dev << 7);
+
+	hash ^= hash >> 17;
+	hash *= 0x9E3779B9U;
+
+	return parse_cache.chains + ((hash >> 8) & (_CONFINI_CACHE_BUCKETS_ - 1));
+
+}
+
+
+/**
+
+	@brief          Remove an entry from the parse cache (the cache must be
+	                locked)
+	@param          entry           The entry to remove
+	@return         Nothing
+
+	The entry is freed immediately, unless some thread is still replaying it.
+
+**/
+static void evict_cache_entry (
+	struct cache_entry * const entry
+) {
+
+	if (entry->chain_prev) {
+
+		entry->chain_prev->chain_next = entry->chain_next;
+
+	} else {
+
+		*hash_cache_key(entry->dev, entry->ino) = entry->chain_next;
+
+	}
+
+	if (entry->chain_next) {
+
+		entry->chain_next->chain_prev = entry->chain_prev;
+
+	}
+
+	if (entry->prev) {
+
+		entry->prev->next = entry->next;
+
+	} else {
+
+		parse_cache.first = entry->next;
+
+	}
+
+	if (entry->next) {
+
+		entry->next->prev = entry->prev;
+
+	} else {
+
+		parse_cache.last = entry->prev;
+
+	}
+
+	parse_cache.cost -= entry->cost;
+
+	if (entry->n_users) {
+
+		entry->is_evicted = _CONFINI_TRUE_;
+
+	} else {
+
+		free_cache_entry(entry);
+
+	}
+
+}
+
+
+/**
+
+	@brief          Check whether a cache entry matches a file and a format
+	@param          entry           The entry to check
+	@param          file_stat       The status of the file
+	@param          format_num      The format, as returned by #ini_fton()
+	@return         A boolean
+
+**/
+static _CONFINI_CHARBOOL_ cache_entry_matches (
+	const struct cache_entry * const entry,
+	const struct stat * const file_stat,
+	const IniFormatNum format_num
+) {
+
+	return
+		entry->dev == file_stat->st_dev &&
+		entry->ino == file_stat->st_ino &&
+		entry->size == file_stat->st_size &&
+		entry->mtime == file_stat->st_mtime &&
+		entry->mtime_nsec == _CONFINI_MTIME_NSEC_(*file_stat) &&
+		entry->format == format_num &&
+		entry->implicit_v_len == INI_GLOBAL_IMPLICIT_V_LEN &&
+		entry->lowercase_mode == INI_GLOBAL_LOWERCASE_MODE && (
+			entry->implicit_value && INI_GLOBAL_IMPLICIT_VALUE ?
+				!strcmp(entry->implicit_value, INI_GLOBAL_IMPLICIT_VALUE)
+			:
+				entry->implicit_value == INI_GLOBAL_IMPLICIT_VALUE
+		);
+
+}
+
+
+/**
+
+	@brief          Find a cache entry and mark it as being in use (the cache
+	                must be locked)
+	@param          file_stat       The status of the file
+	@param          format_num      The format, as returned by #ini_fton()
+	@return         The entry found, or `NULL`
+
+**/
+static struct cache_entry * acquire_cache_entry (
+	const struct stat * const file_stat,
+	const IniFormatNum format_num
+) {
+
+	struct cache_entry * entry =
+		*hash_cache_key(file_stat->st_dev, file_stat->st_ino);
+
+	while (entry && !cache_entry_matches(entry, file_stat, format_num)) {
+
+		entry = entry->chain_next;
+
+	}
+
+	if (!entry) {
+
+		return entry;
+
+	}
+
+	if (entry->prev) {
+
+		/*  Move the entry to the head of the list  */
+
+		entry->prev->next = entry->next;
+
+		if (entry->next) {
+
+			entry->next->prev = entry->prev;
+
+		} else {
+
+			parse_cache.last = entry->prev;
+
+		}
+
+		entry->prev = (struct cache_entry *) 0;
+		entry->next = parse_cache.first;
+		parse_cache.first->prev = entry;
+		parse_cache.first = entry;
+
+	}
+
+	entry->n_users++;
+	return entry;
+
+}
+
+
+/**
+
+	@brief          Dispatch the content of a cache entry as #strip_ini_cache()
+	                would dispatch the file it comes from
+	@param          entry           The entry to replay
+	@param          format          The format of the INI file
+	@param          f_init          The function that will be invoked before the
+	                                first dispatch, or `NULL`
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	The strings are copied into a private buffer before being dispatched, so that
+	the user can modify them without altering the cache.
+
+**/
+static int replay_cache_entry (
+	const struct cache_entry * const entry,
+	const IniFormat format,
+	const IniStatsHandler f_init,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	IniStatistics this_doc = {
+		.format = format,
+		.bytes = entry->bytes,
+		.members = entry->n_nodes
+	};
+
+	if (f_init && f_init(&this_doc, user_data)) {
+
+		return CONFINI_IINTR;
+
+	}
+
+	if (!f_foreach) {
+
+		return CONFINI_SUCCESS;
+
+	}
+
+	char * const strings = (char *) malloc(entry->strings_len);
+
+	if (!strings) {
+
+		return CONFINI_ENOMEM;
+
+	}
+
+	memcpy(strings, entry->strings, entry->strings_len);
+
+	const struct image_node * const nodes =
+		(const struct image_node *) entry->nodes;
+
+	IniDispatch dsp = {
+		.format = format,
+		.dispatch_id = 0
+	};
+
+	for (; dsp.dispatch_id < entry->n_nodes; dsp.dispatch_id++) {
+
+		#define __NODE__ (nodes[dsp.dispatch_id])
+
+		dsp.type = (uint_least8_t) __NODE__.type;
+		dsp.data = strings + __NODE__.d_offs;
+		dsp.d_len = __NODE__.d_len;
+		dsp.append_to = strings + __NODE__.at_offs;
+		dsp.at_len = __NODE__.at_len;
+		dsp.v_len = __NODE__.v_len;
+
+		dsp.value =
+			__NODE__.v_offs == _CONFINI_IMAGE_NO_VALUE_ ?
+				(char *) 0
+			: __NODE__.v_offs == _CONFINI_CACHE_IMPLICIT_ ?
+				INI_GLOBAL_IMPLICIT_VALUE
+			:
+				strings + __NODE__.v_offs;
+
+		#undef __NODE__
+
+		if (f_foreach(&dsp, user_data)) {
+
+			free(strings);
+			return CONFINI_FEINTR;
+
+		}
+
+	}
+
+	free(strings);
+	return CONFINI_SUCCESS;
+
+}
+
+
+/**
+
+	@brief          Statistics handler used while filling a cache entry
+	@param          statistics      The statistics of the file
+	@param          v_recorder      The `struct cache_recorder`
+	@return         The value returned by the user's handler
+
+**/
+static int record_cache_stats (
+	IniStatistics * const statistics,
+	void * const v_recorder
+) {
+
+	#define recorder ((struct cache_recorder *) v_recorder)
+
+	recorder->bytes = statistics->bytes;
+
+	return
+		recorder->f_init ?
+			recorder->f_init(statistics, recorder->user_data)
+		:
+			0;
+
+	#undef recorder
+
+}
+
+
+/**
+
+	@brief          Dispatch handler used while filling a cache entry
+	@param          dispatch        The dispatch to store and forward
+	@param          v_recorder      The `struct cache_recorder`
+	@return         The value returned by the user's handler
+
+	The dispatch is stored before the user's handler gets a chance to modify it.
+	If storing fails the entry is abandoned, but the parsing goes on.
+
+**/
+static int record_cache_node (
+	IniDispatch * const dispatch,
+	void * const v_recorder
+) {
+
+	#define recorder ((struct cache_recorder *) v_recorder)
+
+	if (
+		!recorder->builder.status &&
+		!compile_image_node(dispatch, &recorder->builder) &&
+		dispatch->value &&
+		dispatch->value == INI_GLOBAL_IMPLICIT_VALUE
+	) {
+
+		((struct image_node *) recorder->builder.nodes)[
+			recorder->builder.n_nodes - 1
+		].v_offs = _CONFINI_CACHE_IMPLICIT_;
+
+	}
+
+	return
+		recorder->f_foreach ?
+			recorder->f_foreach(dispatch, recorder->user_data)
+		:
+			0;
+
+	#undef recorder
+
+}
+
+
+/**
+
+	@brief          Parse an INI file using the parse cache
+	@param          path            The path of the INI file
+	@param          format          The format of the INI file
+	@param          f_init          The function that will be invoked before the
+	                                first dispatch, or `NULL`
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	On a hit the cached dispatches are replayed without opening the file. On a
+	miss the file is parsed as usual and, if the parsing was not interrupted and
+	the result fits in the budget, stored in the cache, evicting the least
+	recently used entries as needed.
+
+**/
+static int load_cached_ini_path (
+	const char * const path,
+	const IniFormat format,
+	const IniStatsHandler f_init,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	const IniFormatNum format_num = ini_fton(format);
+	struct cache_entry * entry = (struct cache_entry *) 0;
+	struct stat file_stat;
+	int return_value;
+
+	if (!stat(path, &file_stat) && S_ISREG(file_stat.st_mode)) {
+
+		pthread_mutex_lock(&parse_cache.lock);
+		entry = acquire_cache_entry(&file_stat, format_num);
+		pthread_mutex_unlock(&parse_cache.lock);
+
+	}
+
+	if (entry) {
+
+		return_value = replay_cache_entry(
+			entry,
+			format,
+			f_init,
+			f_foreach,
+			user_data
+		);
+
+		pthread_mutex_lock(&parse_cache.lock);
+
+		if (!--entry->n_users && entry->is_evicted) {
+
+			free_cache_entry(entry);
+
+		}
+
+		pthread_mutex_unlock(&parse_cache.lock);
+		return return_value;
+
+	}
+
+	const int ini_fd = open(path, O_RDONLY);
+
+	if (ini_fd < 0) {
+
+		return CONFINI_ENOENT;
+
+	}
+
+	IniLoadBuffer buffer = { (char *) 0, 0 };
+
+	struct cache_recorder recorder = {
+		.builder = {
+			.nodes = (char *) 0,
+			.strings = (char *) 0,
+			.nodes_size = 0,
+			.strings_size = 0,
+			.n_nodes = 0,
+			.strings_len = 0,
+			.last_at_len = 0,
+			.status = CONFINI_SUCCESS
+		},
+		.f_init = f_init,
+		.f_foreach = f_foreach,
+		.user_data = user_data,
+		.bytes = 0
+	};
+
+	size_t cache_len;
+
+	/*  Key the entry on the file actually read, not on the path  */
+	if (fstat(ini_fd, &file_stat) || !S_ISREG(file_stat.st_mode)) {
+
+		recorder.builder.status = CONFINI_ENOENT;
+
+	} else {
+
+		recorder.builder.status = add_image_string(
+			&recorder.builder,
+			"",
+			0,
+			&recorder.builder.last_at_offs
+		);
+
+	}
+
+	if (!(return_value = read_ini_fd(ini_fd, &buffer, &cache_len))) {
+
+		return_value = strip_ini_cache(
+			buffer.cache,
+			cache_len,
+			format,
+			record_cache_stats,
+			record_cache_node,
+			&recorder
+		);
+
+	}
+
+	/*  No checks here, as there is nothing we can do about it...  */
+	close(ini_fd);
+	free(buffer.cache);
+
+	if (!return_value && !recorder.builder.status) {
+
+		/*  Give back the unused space before the entry is accounted  */
+
+		char * shrunk = (char *) realloc(
+			recorder.builder.nodes,
+			recorder.builder.n_nodes * sizeof(struct image_node) + 1
+		);
+
+		if (shrunk) {
+
+			recorder.builder.nodes = shrunk;
+
+		}
+
+		if (
+			(shrunk = (char *) realloc(
+				recorder.builder.strings,
+				recorder.builder.strings_len
+			))
+		) {
+
+			recorder.builder.strings = shrunk;
+
+		}
+
+	}
+
+	const size_t implicit_size =
+		INI_GLOBAL_IMPLICIT_VALUE ? strlen(INI_GLOBAL_IMPLICIT_VALUE) + 1 : 0;
+
+	const size_t cost =
+		sizeof(struct cache_entry) +
+		recorder.builder.n_nodes * sizeof(struct image_node) +
+		recorder.builder.strings_len + implicit_size;
+
+	char * const implicit_value =
+		!return_value && !recorder.builder.status && implicit_size ?
+			(char *) malloc(implicit_size)
+		:
+			(char *) 0;
+
+	if (
+		return_value ||
+		recorder.builder.status ||
+		(implicit_size && !implicit_value) ||
+		!(entry = (struct cache_entry *) malloc(sizeof(struct cache_entry)))
+	) {
+
+		free(implicit_value);
+		free(recorder.builder.strings);
+		free(recorder.builder.nodes);
+		return return_value;
+
+	}
+
+	if (implicit_value) {
+
+		memcpy(implicit_value, INI_GLOBAL_IMPLICIT_VALUE, implicit_size);
+
+	}
+
+	entry->nodes = recorder.builder.nodes;
+	entry->strings = recorder.builder.strings;
+	entry->n_nodes = recorder.builder.n_nodes;
+	entry->strings_len = recorder.builder.strings_len;
+	entry->bytes = recorder.bytes;
+	entry->cost = cost;
+	entry->n_users = 0;
+	entry->dev = file_stat.st_dev;
+	entry->ino = file_stat.st_ino;
+	entry->mtime = file_stat.st_mtime;
+	entry->mtime_nsec = _CONFINI_MTIME_NSEC_(file_stat);
+	entry->size = file_stat.st_size;
+	entry->format = format_num;
+	entry->implicit_value = implicit_value;
+	entry->implicit_v_len = INI_GLOBAL_IMPLICIT_V_LEN;
+	entry->lowercase_mode = INI_GLOBAL_LOWERCASE_MODE;
+	entry->is_evicted = _CONFINI_FALSE_;
+	entry->prev = (struct cache_entry *) 0;
+	entry->chain_prev = (struct cache_entry *) 0;
+
+	struct cache_entry ** const chain = hash_cache_key(entry->dev, entry->ino);
+
+	pthread_mutex_lock(&parse_cache.lock);
+
+	/*  Drop the older versions of the same file  */
+	for (struct cache_entry * old = *chain, * next; old; old = next) {
+
+		next = old->chain_next;
+
+		if (old->dev == entry->dev && old->ino == entry->ino) {
+
+			evict_cache_entry(old);
+
+		}
+
+	}
+
+	while (parse_cache.last && parse_cache.cost + cost > parse_cache.budget) {
+
+		evict_cache_entry(parse_cache.last);
+
+	}
+
+	if (parse_cache.cost + cost > parse_cache.budget) {
+
+		free_cache_entry(entry);
+
+	} else {
+
+		entry->next = parse_cache.first;
+
+		if (parse_cache.first) {
+
+			parse_cache.first->prev = entry;
+
+		} else {
+
+			parse_cache.last = entry;
+
+		}
+
+		parse_cache.first = entry;
+		parse_cache.cost += cost;
+		entry->chain_next = *chain;
+
+		if (*chain) {
+
+			(*chain)->chain_prev = entry;
+
+		}
+
+		*chain = entry;
+
+	}
+
+	pthread_mutex_unlock(&parse_cache.lock);
+	return CONFINI_SUCCESS;
+
+}
+
+#endif
+
+
+
+/**
+
+	@brief          Check whether an interest set selects a node type
+	@param          interest        The interest set
+	@param          node_type       The node type
+	@return         A boolean: `true` if the node type is selected, `false`
+	                otherwise
+
+**/
+static inline _CONFINI_CHARBOOL_ type_is_wanted (
+	const IniInterestSet * const interest,
+	const uint_least8_t node_type
+) {
+
+	return
+		!interest->node_types ||
+		(interest->node_types & INI_NODE_MASK(node_type));
+
+}
+
+
+/**
+
+	@brief          Check whether the current parent of a parser belongs to its
+	                interest set
+	@param          reader          The state of the parser
+	@return         A boolean: `true` if the keys of the current parent must be
+	                dispatched, `false` otherwise
+
+	The answer is cached until the parent changes. When this function is invoked
+	the path of the parent is contiguous and NUL-terminated.
+
+**/
+static _CONFINI_CHARBOOL_ parent_is_wanted (
+	IniReader * const reader
+) {
+
+	if (
+		reader->checked_parent_str != reader->curr_parent_str ||
+		reader->checked_parent_len != reader->curr_parent_len
+	) {
+
+		reader->checked_parent_str = reader->curr_parent_str;
+		reader->checked_parent_len = reader->curr_parent_len;
+
+		reader->parent_is_wanted =
+			!reader->interest->n_sections || is_in_list(
+				reader->interest->sections,
+				reader->interest->n_sections,
+				reader->curr_parent_str,
+				reader->dispatch.format
+			);
+
+	}
+
+	return reader->parent_is_wanted;
+
+}
+
+
+/**
+
+	@brief          Find the next node of a fragment of a buffer that has already
+	                been cut by #further_cuts(), and prepare its dispatch
+	@param          reader          The state of the parser
+	@param          node_at         The offset where the search must begin; on
+	                                return it points right after the node found
+	@param          frag_end        The offset of the `NUL` character that
+	                                terminates the fragment
+	@return         A boolean: `true` if a node has been found and prepared in
+	                `reader->dispatch`, `false` if the fragment has no more nodes
+
+	The section paths are built in place, by moving each relative section path
+	right after its parent (the space is always available, since both belong to
+	nodes that have already been dispatched). The `dispatch_id` field is left
+	to the caller.
+
+**/
+static inline _CONFINI_CHARBOOL_ next_ini_node (
+	IniReader * const reader,
+	size_t * const node_at,
+	const size_t frag_end
+) {
+
+	#define dsp reader->dispatch
+
+	char * const ini_source = reader->ini_source;
+
+	for (size_t idx = *node_at; idx <= frag_end; idx++) {
+
+		if (ini_source[idx]) {
+
+			continue;
+
+		}
+
+		if (
+			!ini_source[*node_at] ||
+			_CONFINI_IS_IGN_MARKER_(ini_source[*node_at], dsp.format)
+		) {
+
+			*node_at = idx + 1;
+			continue;
+
+		}
+
+		dsp.data = ini_source + *node_at;
+		dsp.d_len = idx - *node_at;
+		*node_at = idx + 1;
+
+		set_dispatch_type(&dsp);
+
+		if (reader->curr_parent_len && reader->subparent_len) {
+
+			size_t iter = 0;
+
+			do {
+
+				reader->curr_parent_str[reader->curr_parent_len + iter] =
+					reader->subparent_str[iter];
+
+			} while (iter++ < reader->subparent_len);
+
+			reader->curr_parent_len += reader->subparent_len;
+			reader->subparent_str = reader->curr_parent_str + reader->curr_parent_len;
+			reader->subparent_len = 0;
+
+		}
+
+		if (reader->parent_is_disabled && !(dsp.type & INI_DISABLED_FLAG)) {
+
+			reader->real_parent_str[reader->real_parent_len] = '\0';
+			reader->curr_parent_len = reader->real_parent_len;
+			reader->curr_parent_str = reader->real_parent_str;
+			reader->parent_is_disabled = _CONFINI_FALSE_;
+
+		} else if (
+			!reader->parent_is_disabled && dsp.type == INI_DISABLED_SECTION
+		) {
+
+			reader->real_parent_len = reader->curr_parent_len;
+			reader->real_parent_str = reader->curr_parent_str;
+			reader->parent_is_disabled = _CONFINI_TRUE_;
+
+		}
+
+		if (
+			reader->interest &&
+			(dsp.type | INI_DISABLED_FLAG) != INI_DISABLED_SECTION && (
+				!type_is_wanted(reader->interest, dsp.type) ||
+				!parent_is_wanted(reader)
+			)
+		) {
+
+			/*  Unwanted nodes are classified, but never normalized  */
+			continue;
+
+		}
+
+		dsp.append_to = reader->curr_parent_str;
+		dsp.at_len = reader->curr_parent_len;
+
+		switch (
+			normalize_dispatch(
+				&dsp,
+				ini_source + idx,
+				reader->valid_delimiter,
+				reader->interest,
+				reader->options
+			)
+		) {
+
+			case 0:
+
+				continue;
+
+			case _CONFINI_RAW_VALUE_:
+
+				reader->value_is_raw = _CONFINI_TRUE_;
+				break;
+
+			default:
+
+				reader->value_is_raw = _CONFINI_FALSE_;
+
+		}
+
+		if ((dsp.type | INI_DISABLED_FLAG) == INI_DISABLED_SECTION) {
+
+			if (
+				dsp.format.section_paths == INI_ONE_LEVEL_ONLY ||
+				*dsp.data != _CONFINI_SUBSECTION_
+			) {
+
+				/*
+
+					Append to root (this is an absolute path)
+
+				*/
+
+				reader->curr_parent_str = dsp.data;
+				reader->curr_parent_len = dsp.d_len;
+				reader->subparent_str = ini_source + idx;
+				reader->subparent_len = 0;
+				dsp.append_to = reader->subparent_str;
+				dsp.at_len = 0;
+
+			} else if (
+				dsp.format.section_paths == INI_ABSOLUTE_ONLY ||
+				!reader->curr_parent_len
+			) {
+
+				/*
+
+					Append to root and remove the leading dot (parent is root or
+					relative paths are not allowed)
+
+				*/
+
+				reader->curr_parent_str = ++dsp.data;
+				reader->curr_parent_len = --dsp.d_len;
+				reader->subparent_str = ini_source + idx;
+				reader->subparent_len = 0;
+				dsp.append_to = reader->subparent_str;
+				dsp.at_len = 0;
+
+			} else if (dsp.d_len != 1) {
+
+				/*
+
+					Append to the current parent (this is a relative path and
+					parent is not root)
+
+				*/
+
+				reader->subparent_str = dsp.data;
+				reader->subparent_len = dsp.d_len;
+
+			}
+
+			if (
+				reader->interest &&
+				!type_is_wanted(reader->interest, dsp.type)
+			) {
+
+				/*  The section is needed only as parent of other nodes  */
+				continue;
+
+			}
+
+		}
+
+		return _CONFINI_TRUE_;
+
+	}
+
+	#undef dsp
+
+	*node_at = frag_end + 1;
+
+	return _CONFINI_FALSE_;
+
+}
+
+
+/**
+
+	@brief          Dispatch the nodes of a fragment of a buffer that has already
+	                been cut by #further_cuts()
+	@param          reader          The state of the parser
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch
+	@param          user_data       A custom argument, or `NULL`
+	@param          node_at         The offset where the fragment begins
+	@param          frag_end        The offset of the `NUL` character that
+	                                terminates the fragment
+	@param          max_id          The dispatch ID that must not be reached
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	Reaching @p max_id means that the fragment contains more nodes than
+	#further_cuts() had counted, and #CONFINI_EOOR is returned.
+
+**/
+static inline int dispatch_ini_nodes (
+	IniReader * const reader,
+	const IniDispHandler f_foreach,
+	void * const user_data,
+	size_t node_at,
+	const size_t frag_end,
+	const size_t max_id
+) {
+
+	while (next_ini_node(reader, &node_at, frag_end)) {
+
+		if (reader->dispatch.dispatch_id >= max_id) {
+
+			return CONFINI_EOOR;
+
+		}
+
+		if (f_foreach(&reader->dispatch, user_data)) {
+
+			return CONFINI_FEINTR;
+
+		}
+
+		reader->dispatch.dispatch_id++;
+
+	}
+
+	return CONFINI_SUCCESS;
+
+}
+
+
+/**
+
+	@brief          Cut a segment of a buffer into nodes and, in single-pass mode,
+	                dispatch them immediately
+	@param          reader          The state of the parser
+	@param          seg_at          The offset where the segment begins
+	@param          seg_end         The offset of the `NUL` character that
+	                                terminates the segment
+	@param          n_members       The counter of the members found so far
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL` if the nodes must only be
+	                                counted
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+**/
+static inline int cut_ini_segment (
+	IniReader * const reader,
+	const size_t seg_at,
+	const size_t seg_end,
+	size_t * const n_members,
+	const IniDispHandler f_foreach,
+	void * const user_data,
+	const IniFormat format
+) {
+
+	const size_t seg_members = further_cuts(
+		reader->ini_source + qultrim_h(reader->ini_source, seg_at, format),
+		format
+	);
+
+	*n_members += seg_members;
+
+	return
+		f_foreach ?
+			dispatch_ini_nodes(
+				reader,
+				f_foreach,
+				user_data,
+				seg_at,
+				seg_end,
+				reader->dispatch.dispatch_id + seg_members
+			)
+		:
+			CONFINI_SUCCESS;
+
+}
+
+
+/**
+
+	@brief          The parser behind #strip_ini_cache()
+	@param          ini_source      The buffer containing the INI file to tokenize
+	@param          ini_length      The length of @p ini_source without counting the
+	                                NUL terminator
+	@param          format          The format of the INI file
+	@param          options         The implicit value and the lowercase mode, or
+	                                `NULL` for using the global ones
+	@param          f_init          The function that will be invoked before the
+	                                first dispatch, or `NULL`
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	This function is kept separate from #strip_ini_cache() so that it can be
+	instantiated once for each format listed in `CONFINI_SPECIALIZED_FORMATS`
+	(see below).
+
+	The buffer is normally parsed in two passes: the first one cuts it into nodes
+	and counts them, the second one dispatches them. When there is no @p f_init
+	callback the count is not needed, and each line is dispatched as soon as it
+	has been cut, while it is still in cache.
+
+**/
+static int tokenize_ini_cache (
+	register char * const ini_source,
+	const size_t ini_length,
+	const IniFormat format,
+	const IniParseOptions * const options,
+	const IniStatsHandler f_init,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	IniReader reader = {
+		.dispatch = {
+			.format = format,
+			.dispatch_id = 0
+		},
+		.ini_source = ini_source,
+		.curr_parent_str = ini_source + ini_length,
+		.subparent_str = ini_source + ini_length,
+		.real_parent_str = ini_source + ini_length,
+		.curr_parent_len = 0,
+		.subparent_len = 0,
+		.real_parent_len = 0,
+		.options = options,
+		.parent_is_disabled = _CONFINI_FALSE_,
+		.valid_delimiter = !_CONFINI_IS_ESC_CHAR_(format.delimiter_symbol, format)
+	};
+
+	/*  Single-pass mode: dispatch each segment as soon as it has been cut  */
+	const IniDispHandler fused_foreach = f_init ? (IniDispHandler) 0 : f_foreach;
+
+	_CONFINI_CHARBOOL_ tmp_bool;
+	register size_t idx, tmp_fast_size_t_1, tmp_fast_size_t_2;
+	size_t tmp_size_t_1, n_members = 0;
+	int return_value;
+
+	ini_source[ini_length] = '\0';
+
+	/*
+
+		PART ONE: Examine and isolate each segment
+
+	*/
+
+	#define __ISNT_ESCAPED__ tmp_bool
+	#define __LSHIFT__ tmp_fast_size_t_1
+	#define __EOL_N__ tmp_fast_size_t_2
+	#define __NL_AT__ tmp_size_t_1
+
+	/*  UTF-8 BOM  */
+	__LSHIFT__ =
+		*((unsigned char *) ini_source) == 0xEF &&
+		*((unsigned char *) ini_source + 1) == 0xBB &&
+		*((unsigned char *) ini_source + 2) == 0xBF
+		? 3 : 0;
+
+	/*
+
+	As long as there are no BOM and no `NUL` characters nothing must be moved --
+	which is the case of almost every file. The first loop takes care of this
+	case, and leaves the rest of the buffer to the second loop as soon as it
+	finds a `NUL` character.
+
+	*/
+
+	for (
+
+		__EOL_N__ = _CONFINI_EOL_IDX_,
+		__ISNT_ESCAPED__ = _CONFINI_TRUE_,
+		__NL_AT__ = 0,
+		idx = __LSHIFT__;
+
+			!__LSHIFT__ && idx < ini_length && ini_source[idx];
+
+		idx++
+
+	) {
+
+		if (
+			ini_source[idx] == _CONFINI_SPACES_[__EOL_N__] ||
+			ini_source[idx] == _CONFINI_SPACES_[__EOL_N__ ^= 1]
+		) {
+
+			if (format.multiline_nodes == INI_NO_MULTILINE || __ISNT_ESCAPED__) {
+
+				ini_source[idx] = '\0';
+
+				if (
+					(return_value = cut_ini_segment(
+						&reader,
+						__NL_AT__,
+						idx,
+						&n_members,
+						fused_foreach,
+						user_data,
+						format
+					))
+				) {
+
+					return return_value;
+
+				}
+
+				__NL_AT__ = idx + 1;
+
+			} else if (ini_source[idx + 1] == _CONFINI_SPACES_[__EOL_N__ ^ 1]) {
+
+				idx++;
+
+			}
+
+			__ISNT_ESCAPED__ = _CONFINI_TRUE_;
+
+		} else if (ini_source[idx] == _CONFINI_BACKSLASH_) {
+
+			__ISNT_ESCAPED__ = !__ISNT_ESCAPED__;
+
+		} else {
+
+			__ISNT_ESCAPED__ = _CONFINI_TRUE_;
+			idx = skip_plain_chars(ini_source, idx + 1, ini_length) - 1;
+
+		}
+
+	}
+
+	for (; idx < ini_length; idx++) {
+
+		ini_source[idx - __LSHIFT__] = ini_source[idx];
+
+		if (
+			ini_source[idx] == _CONFINI_SPACES_[__EOL_N__] ||
+			ini_source[idx] == _CONFINI_SPACES_[__EOL_N__ ^= 1]
+		) {
+
+			if (format.multiline_nodes == INI_NO_MULTILINE || __ISNT_ESCAPED__) {
+
+				ini_source[idx - __LSHIFT__] = '\0';
+
+				if (
+					(return_value = cut_ini_segment(
+						&reader,
+						__NL_AT__,
+						idx - __LSHIFT__,
+						&n_members,
+						fused_foreach,
+						user_data,
+						format
+					))
+				) {
+
+					return return_value;
+
+				}
+
+				__NL_AT__ = idx - __LSHIFT__ + 1;
+
+			} else if (ini_source[idx + 1] == _CONFINI_SPACES_[__EOL_N__ ^ 1]) {
+
+				idx++;
+				ini_source[idx - __LSHIFT__] = ini_source[idx];
+
+			}
+
+			__ISNT_ESCAPED__ = _CONFINI_TRUE_;
+
+		} else if (ini_source[idx] == _CONFINI_BACKSLASH_) {
+
+			__ISNT_ESCAPED__ = !__ISNT_ESCAPED__;
+
+		} else if (ini_source[idx]) {
+
+			__ISNT_ESCAPED__ = _CONFINI_TRUE_;
+
+			/*  Jump to the next character that deserves attention  */
+
+			const size_t plain_end = skip_plain_chars(ini_source, idx + 1, ini_length);
+
+			if (__LSHIFT__) {
+
+				while (++idx < plain_end) {
+
+					ini_source[idx - __LSHIFT__] = ini_source[idx];
+
+				}
+
+			}
+
+			idx = plain_end - 1;
+
+		} else {
+
+			/*  Remove `NUL` characters from the buffer (if any)  */
+			__LSHIFT__++;
+
+		}
+
+	}
+
+	const size_t real_length = idx - __LSHIFT__;
+
+	while (idx > real_length) {
+
+		ini_source[--idx] = '\0';
+
+	}
+
+	if (
+		(return_value = cut_ini_segment(
+			&reader,
+			__NL_AT__,
+			real_length,
+			&n_members,
+			fused_foreach,
+			user_data,
+			format
+		))
+	) {
+
+		return return_value;
+
+	}
+
+	#undef __NL_AT__
+	#undef __EOL_N__
+	#undef __LSHIFT__
+	#undef __ISNT_ESCAPED__
+
+	/*  Debug  */
+
+	/*
+
+	for (size_t tmp = 0; tmp < ini_length + 1; tmp++) {
+		putchar(ini_source[tmp] == 0 ? '$' : ini_source[tmp]);
+	}
+	putchar('\n');
+
+	*/
+
+	if (!f_init) {
+
+		return CONFINI_SUCCESS;
+
+	}
+
+	IniStatistics this_doc = {
+		.format = format,
+		.bytes = ini_length,
+		.members = n_members
+	};
+
+	if (f_init(&this_doc, user_data)) {
+
+		return CONFINI_IINTR;
+
+	}
+
+	/*
+
+		PART TWO: Dispatch the parsed input
+
+	*/
+
+	return
+		f_foreach ?
+			dispatch_ini_nodes(
+				&reader,
+				f_foreach,
+				user_data,
+				0,
+				real_length,
+				n_members
+			)
+		:
+			CONFINI_SUCCESS;
+
+}
+
+
+#ifdef CONFINI_SPECIALIZED_FORMATS
+
+/*
+
+	Copies of #tokenize_ini_cache() specialized for a fixed format.
+
+	`CONFINI_SPECIALIZED_FORMATS` is a comma-separated list of up to eight
+	#IniFormatNum literals (see the `--with-specialized-formats` option of the
+	`configure` script). Each copy gets the format as a constant and, where the
+	compiler supports it, has all the parsing helpers inlined into itself, so that
+	every test on the format can be folded at compile time.
+
+*/
+#define __SPECIALIZE_FORMAT__(FORMAT_NUM) \
+	static int _CONFINI_FLATTEN_ strip_ini_cache_##FORMAT_NUM ( \
+		char * const ini_source, \
+		const size_t ini_length, \
+		const IniParseOptions * const options, \
+		const IniStatsHandler f_init, \
+		const IniDispHandler f_foreach, \
+		void * const user_data \
+	) { \
+		return tokenize_ini_cache( \
+			ini_source, \
+			ini_length, \
+			ini_ntof(FORMAT_NUM), \
+			options, \
+			f_init, \
+			f_foreach, \
+			user_data \
+		); \
+	}
+
+_CONFINI_FOR_EACH_(__SPECIALIZE_FORMAT__, CONFINI_SPECIALIZED_FORMATS)
+
+#undef __SPECIALIZE_FORMAT__
+
+#endif
+
+
+/**
+
+	@brief          Isolate the next segment of the buffer of a pull-style parser
+	                and cut it into nodes
+	@param          reader          The state of the parser
+	@return         A boolean: `true` if a new segment is available, `false` if
+	                the whole buffer has already been read
+
+	This is the first part of #tokenize_ini_cache() turned into a resumable
+	loop: it stops at the end of each segment, saving its state in @p reader.
+
+**/
+static _CONFINI_CHARBOOL_ read_ini_segment (
+	IniReader * const reader
+) {
+
+	char * const ini_source = reader->ini_source;
+	const size_t ini_length = reader->ini_length;
+	const IniFormat format = reader->dispatch.format;
+	register size_t idx = reader->scan_at, lshift = reader->lshift;
+	size_t eol_n = reader->eol_n;
+	_CONFINI_CHARBOOL_ isnt_escaped = reader->isnt_escaped;
+
+	if (idx > ini_length) {
+
+		return _CONFINI_FALSE_;
+
+	}
+
+	for (; idx < ini_length; idx++) {
+
+		ini_source[idx - lshift] = ini_source[idx];
+
+		if (
+			ini_source[idx] == _CONFINI_SPACES_[eol_n] ||
+			ini_source[idx] == _CONFINI_SPACES_[eol_n ^= 1]
+		) {
+
+			if (format.multiline_nodes == INI_NO_MULTILINE || isnt_escaped) {
+
+				ini_source[idx - lshift] = '\0';
+				reader->seg_end = idx - lshift;
+				reader->scan_at = idx + 1;
+				reader->lshift = lshift;
+				reader->eol_n = eol_n;
+				reader->isnt_escaped = _CONFINI_TRUE_;
+				goto cut_segment;
+
+			} else if (ini_source[idx + 1] == _CONFINI_SPACES_[eol_n ^ 1]) {
+
+				idx++;
+				ini_source[idx - lshift] = ini_source[idx];
+
+			}
+
+			isnt_escaped = _CONFINI_TRUE_;
+
+		} else if (ini_source[idx] == _CONFINI_BACKSLASH_) {
+
+			isnt_escaped = !isnt_escaped;
+
+		} else if (ini_source[idx]) {
+
+			isnt_escaped = _CONFINI_TRUE_;
+
+			/*  Jump to the next character that deserves attention  */
+
+			const size_t plain_end = skip_plain_chars(ini_source, idx + 1, ini_length);
+
+			if (lshift) {
+
+				while (++idx < plain_end) {
+
+					ini_source[idx - lshift] = ini_source[idx];
+
+				}
+
+			}
+
+			idx = plain_end - 1;
+
+		} else {
+
+			/*  Remove `NUL` characters from the buffer (if any)  */
+			lshift++;
+
+		}
+
+	}
+
+	/*  This is the last segment  */
+
+	reader->seg_end = idx - lshift;
+	reader->scan_at = ini_length + 1;
+
+	while (idx > reader->seg_end) {
+
+		ini_source[--idx] = '\0';
+
+	}
+
+	cut_segment:
+
+	reader->node_at = reader->seg_at;
+
+	reader->max_id = reader->next_id + further_cuts(
+		ini_source + qultrim_h(ini_source, reader->seg_at, format),
+		format
+	);
+
+	reader->seg_at = reader->seg_end + 1;
+
+	return _CONFINI_TRUE_;
+
+}
+
+
+/**
+
+	@brief          Read the next node of a pull-style parser
+	@param          reader          The state of the parser
+	@return         Zero for success, #CONFINI_EOF if there are no more nodes,
+	                otherwise an error code (see `enum` #ConfiniInterruptNo)
+
+**/
+static inline int pull_ini_node (
+	IniReader * const reader
+) {
+
+	while (!next_ini_node(reader, &reader->node_at, reader->seg_end)) {
+
+		if (!read_ini_segment(reader)) {
+
+			return CONFINI_EOF;
+
+		}
+
+	}
+
+	if (reader->next_id >= reader->max_id) {
+
+		return CONFINI_EOOR;
+
+	}
+
+	reader->dispatch.dispatch_id = reader->next_id++;
+
+	return CONFINI_SUCCESS;
+
+}
+
+
+/**
+
+	@brief          Cut the whole buffer of a pull-style parser into nodes and
+	                count them, before the first node is read
+	@param          reader          The state of the parser, as returned by
+	                                #ini_reader_init()
+	@return         The number of nodes
+
+	After this function has returned the parser reads the nodes exactly as
+	#tokenize_ini_cache() dispatches them when there is an `f_init` callback.
+
+**/
+static size_t count_ini_nodes (
+	IniReader * const reader
+) {
+
+	size_t n_members = 0;
+
+	while (read_ini_segment(reader)) {
+
+		n_members += reader->max_id - reader->next_id;
+
+	}
+
+	reader->node_at = 0;
+	reader->max_id = n_members;
+
+	return n_members;
+
+}
+
+
+/**
+
+	@brief          The state of #ini_tape_build() while it collects the nodes
+
+	Relative section paths are joined in one of the two `parents` buffers instead
+	of in the buffer being parsed, so that the strings of the nodes already
+	stored are never overwritten.
+
+**/
+struct tape_builder {
+	char * records;
+	char * sections;
+	char * paths;
+	char * parents[2];
+	size_t records_size;
+	size_t sections_size;
+	size_t paths_size;
+	size_t parents_size[2];
+	size_t n_records;
+	size_t n_sections;
+	size_t paths_len;
+};
+
+
+/**
+
+	@brief          Initialize a #tape_builder structure
+	@param          builder         The structure to initialize
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	The buffers of @p builder must be freed even if this function fails.
+
+**/
+static int start_tape_builder (
+	struct tape_builder * const builder
+) {
+
+	builder->records = (char *) 0;
+	builder->sections = (char *) 0;
+	builder->paths = (char *) 0;
+	builder->parents[0] = (char *) 0;
+	builder->parents[1] = (char *) 0;
+	builder->records_size = 0;
+	builder->sections_size = 0;
+	builder->paths_size = 0;
+	builder->parents_size[0] = 0;
+	builder->parents_size[1] = 0;
+	builder->n_records = 0;
+	builder->n_sections = 1;
+	builder->paths_len = 1;
+
+	/*  The root path, shared by all the nodes that precede the first section  */
+
+	const int return_value =
+		grow_buffer(&builder->paths, &builder->paths_size, 1) ||
+		grow_buffer(
+			&builder->sections,
+			&builder->sections_size,
+			sizeof(IniTapeSection)
+		);
+
+	if (return_value) {
+
+		return return_value;
+
+	}
+
+	*builder->paths = '\0';
+	((IniTapeSection *) builder->sections)->offs = 0;
+	((IniTapeSection *) builder->sections)->len = 0;
+
+	return CONFINI_SUCCESS;
+
+}
+
+
+/**
+
+	@brief          Move the current parent of a pull-style parser out of the
+	                buffer, if the next node is going to append a relative path to
+	                it
+	@param          builder         The tape being built
+	@param          reader          The state of the parser
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	The real parent of a disabled section, which is restored after the disabled
+	section has ended, never shares its buffer with the current parent.
+
+**/
+static int move_tape_parent (
+	struct tape_builder * const builder,
+	IniReader * const reader
+) {
+
+	if (!reader->curr_parent_len || !reader->subparent_len) {
+
+		return CONFINI_SUCCESS;
+
+	}
+
+	const size_t slot =
+		reader->curr_parent_str == builder->parents[0] ? 0
+		: reader->curr_parent_str == builder->parents[1] ? 1
+		: reader->parent_is_disabled &&
+			reader->real_parent_str == builder->parents[0];
+
+	const _CONFINI_CHARBOOL_
+		parent_is_moved = reader->curr_parent_str == builder->parents[slot],
+		real_is_moved = reader->real_parent_str == builder->parents[slot];
+
+	const int grow_err = grow_buffer(
+		builder->parents + slot,
+		builder->parents_size + slot,
+		reader->curr_parent_len + reader->subparent_len + 1
+	);
+
+	if (grow_err) {
+
+		return grow_err;
+
+	}
+
+	if (!parent_is_moved) {
+
+		for (size_t idx = 0; idx < reader->curr_parent_len; idx++) {
+
+			builder->parents[slot][idx] = reader->curr_parent_str[idx];
+
+		}
+
+	} else if (real_is_moved) {
+
+		reader->real_parent_str = builder->parents[slot];
+
+	}
+
+	reader->curr_parent_str = builder->parents[slot];
+
+	return CONFINI_SUCCESS;
+
+}
+
+
+/**
+
+	@brief          Store a dispatch into a tape being built
+	@param          builder         The tape being built
+	@param          dispatch        The dispatch to store
+	@param          base            The address the offsets of the record will
+	                                refer to
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	Consecutive nodes that belong to the same section share the same copy of the
+	section path.
+
+**/
+static int add_tape_record (
+	struct tape_builder * const builder,
+	const IniDispatch * const dispatch,
+	const char * const base
+) {
+
+	IniTapeSection * section =
+		(IniTapeSection *) builder->sections + builder->n_sections - 1;
+
+	_CONFINI_CHARBOOL_ at_is_new = dispatch->at_len != section->len;
+	int return_value;
+
+	for (size_t idx = 0; !at_is_new && idx < dispatch->at_len; idx++) {
+
+		at_is_new =
+			dispatch->append_to[idx] != builder->paths[section->offs + idx];
+
+	}
+
+	if (at_is_new) {
+
+		if (builder->paths_len + dispatch->at_len >= INI_TAPE_IMPLICIT_VALUE) {
+
+			return CONFINI_EFBIG;
+
+		}
+
+		if (
+			(return_value = grow_buffer(
+				&builder->sections,
+				&builder->sections_size,
+				(builder->n_sections + 1) * sizeof(IniTapeSection)
+			)) || (return_value = grow_buffer(
+				&builder->paths,
+				&builder->paths_size,
+				builder->paths_len + dispatch->at_len + 1
+			))
+		) {
+
+			return return_value;
+
+		}
+
+		section = (IniTapeSection *) builder->sections + builder->n_sections++;
+		section->offs = (uint_least32_t) builder->paths_len;
+		section->len = (uint_least32_t) dispatch->at_len;
+
+		for (size_t idx = 0; idx < dispatch->at_len; idx++) {
+
+			builder->paths[builder->paths_len + idx] = dispatch->append_to[idx];
+
+		}
+
+		builder->paths[builder->paths_len + dispatch->at_len] = '\0';
+		builder->paths_len += dispatch->at_len + 1;
+
+	}
+
+	if (
+		(return_value = grow_buffer(
+			&builder->records,
+			&builder->records_size,
+			(builder->n_records + 1) * sizeof(IniTapeRecord)
+		))
+	) {
+
+		return return_value;
+
+	}
+
+	IniTapeRecord * const record =
+		(IniTapeRecord *) builder->records + builder->n_records++;
+
+	record->d_offs = (uint_least32_t) (dispatch->data - base);
+	record->d_len = (uint_least32_t) dispatch->d_len;
+	record->section = (uint_least32_t) (builder->n_sections - 1);
+	record->type = dispatch->type;
+
+	/*  An implicit key is recognized by its type, since its value can be `NULL`  */
+	if (
+		dispatch->format.implicit_is_not_empty &&
+		(dispatch->type | INI_DISABLED_FLAG) == INI_DISABLED_KEY &&
+		dispatch->value == INI_GLOBAL_IMPLICIT_VALUE
+	) {
+
+		record->v_offs = INI_TAPE_IMPLICIT_VALUE;
+		record->v_len = (uint_least32_t) dispatch->v_len;
+
+	} else if (!dispatch->value) {
+
+		record->v_offs = INI_TAPE_NO_VALUE;
+		record->v_len = 0;
+
+	} else {
+
+		record->v_offs = (uint_least32_t) (dispatch->value - base);
+		record->v_len = (uint_least32_t) dispatch->v_len;
+
+	}
+
+	return CONFINI_SUCCESS;
+
+}
+
+
+/**
+
+	@brief          Compare a section path and a key name with a record of a tape
+	@param          tape            The tape
+	@param          section         The section path
+	@param          section_len     The length of @p section
+	@param          key             The key name
+	@param          key_len         The length of @p key
+	@param          record          The record to compare
+	@return         A negative number, zero or a positive number, as `strcmp()`
+	                does
+
+	Section paths are compared first. If the format of the tape is
+	case-insensitive the case of the ASCII letters is ignored.
+
+**/
+static int compare_tape_key (
+	const IniTape * const tape,
+	const char * section,
+	size_t section_len,
+	const char * key,
+	size_t key_len,
+	const IniTapeRecord * const record
+) {
+
+	const _CONFINI_CHARBOOL_ case_fold = !tape->format.case_sensitive;
+	const char * other = tape->paths + tape->sections[record->section].offs;
+	size_t other_len = tape->sections[record->section].len, idx;
+	unsigned char chr_a, chr_b;
+
+	for (_CONFINI_CHARBOOL_ is_key = _CONFINI_FALSE_; ; is_key = _CONFINI_TRUE_) {
+
+		for (idx = 0; idx < section_len && idx < other_len; idx++) {
+
+			chr_a = (unsigned char) (
+				case_fold ? _CONFINI_CHR_CASEFOLD_(section[idx]) : section[idx]
+			);
+
+			chr_b = (unsigned char) (
+				case_fold ? _CONFINI_CHR_CASEFOLD_(other[idx]) : other[idx]
+			);
+
+			if (chr_a != chr_b) {
+
+				return chr_a < chr_b ? -1 : 1;
+
+			}
+
+		}
+
+		if (section_len != other_len) {
+
+			return section_len < other_len ? -1 : 1;
+
+		}
+
+		if (is_key) {
+
+			return 0;
+
+		}
+
+		section = key;
+		section_len = key_len;
+		other = tape->ini_source + record->d_offs;
+		other_len = record->d_len;
+
+	}
+
+}
+
+
+/**
+
+	@brief          Sort the keys of a tape by section path and key name
+	@param          tape            The tape
+	@param          keys            The indices of the records of the keys, in
+	                                the order in which they were dispatched
+	@param          tmp             A scratch array as long as @p keys
+	@param          n_keys          The number of keys
+	@return         Nothing
+
+	This is a bottom-up merge sort: keys that compare equal keep the order in
+	which they were dispatched.
+
+**/
+static void sort_tape_keys (
+	const IniTape * const tape,
+	uint_least32_t * const keys,
+	uint_least32_t * const tmp,
+	const size_t n_keys
+) {
+
+	uint_least32_t * src = keys, * dst = tmp, * swap;
+	const IniTapeRecord * right_rec;
+	size_t width, left, right, left_end, right_end, idx;
+
+	for (width = 1; width < n_keys; width <<= 1) {
+
+		for (left = 0; left < n_keys; left = right_end) {
+
+			left_end = right = n_keys - left > width ? left + width : n_keys;
+			right_end = n_keys - right > width ? right + width : n_keys;
+
+			for (idx = left; idx < right_end; idx++) {
+
+				if (right == right_end) {
+
+					dst[idx] = src[left++];
+					continue;
+
+				}
+
+				right_rec = tape->records + src[right];
+
+				dst[idx] =
+					left == left_end || compare_tape_key(
+						tape,
+						tape->paths + tape->sections[right_rec->section].offs,
+						tape->sections[right_rec->section].len,
+						tape->ini_source + right_rec->d_offs,
+						right_rec->d_len,
+						tape->records + src[left]
+					) < 0 ?
+						src[right++]
+					:
+						src[left++];
+
+			}
+
+		}
+
+		swap = src;
+		src = dst;
+		dst = swap;
+
+	}
+
+	if (src != keys) {
+
+		for (idx = 0; idx < n_keys; idx++) {
+
+			keys[idx] = src[idx];
+
+		}
+
+	}
+
+}
+
+
+/**
+
+	@brief  The section context of a segment of an #IniDocument, as it is before
+	        the first node of the segment
+
+	All the paths are stored in the `paths` member of the document. The real
+	parent is meaningful only within disabled sections.
+
+**/
+struct doc_context {
+	IniTapeSection parent;
+	IniTapeSection real_parent;
+	_CONFINI_CHARBOOL_ parent_is_disabled;
+};
+
+
+/**
+
+	@brief  A segment of an #IniDocument -- i.e. a line, or a group of lines
+	        joined by escaped line breaks
+
+**/
+struct doc_segment {
+	size_t at;
+	size_t n_nodes;
+	struct doc_context context;
+};
+
+
+/**
+
+	@brief  A document that can be parsed again incrementally (see
+	        #ini_document_open())
+
+	The `segments` buffer holds #doc_segment structures sorted by offset. The
+	section paths referred to by their contexts are only ever appended to
+	`paths`, which is freed together with the document.
+
+**/
+struct IniDocument {
+	char * text;
+	char * segments;
+	char * paths;
+	size_t text_len;
+	size_t text_size;
+	size_t n_segments;
+	size_t segments_size;
+	size_t paths_len;
+	size_t paths_size;
+	IniFormat format;
+};
+
+
+/**
+
+	@brief  The nodes of a group of consecutive segments of an #IniDocument,
+	        parsed by #parse_doc_region()
+
+	The segments are copied into `region`, where they are tokenized, and the
+	nodes are stored as tape records whose offsets refer to `region`.
+
+**/
+struct doc_parse {
+	struct tape_builder builder;
+	char * region;
+	char * segments;
+	size_t region_len;
+	size_t region_size;
+	size_t n_segments;
+	size_t segments_size;
+};
+
+
+/**
+
+	@brief          Find where the next segment of a text begins
+	@param          text            The text
+	@param          idx             The offset where the current segment begins
+	@param          text_len        The length of @p text
+	@param          format          The format of the text
+	@return         The offset of the next segment, or `text_len + 1` if the
+	                current segment is the last one
+
+	The text is split exactly as #tokenize_ini_cache() would split it.
+
+**/
+static size_t find_doc_segment_end (
+	const char * const text,
+	size_t idx,
+	const size_t text_len,
+	const IniFormat format
+) {
+
+	_CONFINI_CHARBOOL_ isnt_escaped = _CONFINI_TRUE_;
+
+	for (; idx < text_len; idx++) {
+
+		if (text[idx] == _CONFINI_LF_ || text[idx] == _CONFINI_CR_) {
+
+			if (format.multiline_nodes == INI_NO_MULTILINE || isnt_escaped) {
+
+				return idx + 1;
+
+			}
+
+			if (
+				idx + 1 < text_len &&
+				text[idx + 1] == (
+					text[idx] == _CONFINI_LF_ ? _CONFINI_CR_ : _CONFINI_LF_
+				)
+			) {
+
+				idx++;
+
+			}
+
+			isnt_escaped = _CONFINI_TRUE_;
+
+		} else if (text[idx] == _CONFINI_BACKSLASH_) {
+
+			isnt_escaped = !isnt_escaped;
+
+		} else if (text[idx]) {
+
+			isnt_escaped = _CONFINI_TRUE_;
+
+		}
+
+	}
+
+	return text_len + 1;
+
+}
+
+
+/**
+
+	@brief          Check whether a path of a document is equal to the
+	                concatenation of two strings
+	@param          doc             The document
+	@param          path            The path
+	@param          str_a           The first string
+	@param          len_a           The length of @p str_a
+	@param          str_b           The second string
+	@param          len_b           The length of @p str_b
+	@return         A boolean
+
+**/
+static _CONFINI_CHARBOOL_ doc_path_equals (
+	const IniDocument * const doc,
+	const IniTapeSection path,
+	const char * const str_a,
+	const size_t len_a,
+	const char * const str_b,
+	const size_t len_b
+) {
+
+	size_t idx;
+
+	if (path.len != len_a + len_b) {
+
+		return _CONFINI_FALSE_;
+
+	}
+
+	for (idx = 0; idx < len_a; idx++) {
+
+		if (doc->paths[path.offs + idx] != str_a[idx]) {
+
+			return _CONFINI_FALSE_;
+
+		}
+
+	}
+
+	for (idx = 0; idx < len_b; idx++) {
+
+		if (doc->paths[path.offs + len_a + idx] != str_b[idx]) {
+
+			return _CONFINI_FALSE_;
+
+		}
+
+	}
+
+	return _CONFINI_TRUE_;
+
+}
+
+
+/**
+
+	@brief          Store the concatenation of two strings as a path of a
+	                document, unless it is equal to a path already known
+	@param          doc             The document
+	@param          known           The path already known
+	@param          str_a           The first string
+	@param          len_a           The length of @p str_a
+	@param          str_b           The second string
+	@param          len_b           The length of @p str_b
+	@param          dest            The address where to store the path
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+**/
+static int store_doc_path (
+	IniDocument * const doc,
+	const IniTapeSection known,
+	const char * const str_a,
+	const size_t len_a,
+	const char * const str_b,
+	const size_t len_b,
+	IniTapeSection * const dest
+) {
+
+	size_t idx;
+
+	if (doc_path_equals(doc, known, str_a, len_a, str_b, len_b)) {
+
+		*dest = known;
+		return CONFINI_SUCCESS;
+
+	}
+
+	if (doc->paths_len + len_a + len_b >= INI_TAPE_IMPLICIT_VALUE) {
+
+		return CONFINI_EFBIG;
+
+	}
+
+	const int grow_err = grow_buffer(
+		&doc->paths,
+		&doc->paths_size,
+		doc->paths_len + len_a + len_b + 1
+	);
+
+	if (grow_err) {
+
+		return grow_err;
+
+	}
+
+	for (idx = 0; idx < len_a; idx++) {
+
+		doc->paths[doc->paths_len + idx] = str_a[idx];
+
+	}
+
+	for (idx = 0; idx < len_b; idx++) {
+
+		doc->paths[doc->paths_len + len_a + idx] = str_b[idx];
+
+	}
+
+	doc->paths[doc->paths_len + len_a + len_b] = '\0';
+	dest->offs = (uint_least32_t) doc->paths_len;
+	dest->len = (uint_least32_t) (len_a + len_b);
+	doc->paths_len += len_a + len_b + 1;
+
+	return CONFINI_SUCCESS;
+
+}
+
+
+/**
+
+	@brief          Store the section context of a pull-style parser
+	@param          doc             The document being parsed
+	@param          reader          The state of the parser
+	@param          known           The last context stored, whose paths are
+	                                reused when they have not changed (it can be
+	                                @p dest itself)
+	@param          dest            The address where to store the context
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	A relative path that is still waiting to be appended to the current parent
+	is appended at once.
+
+**/
+static int store_doc_context (
+	IniDocument * const doc,
+	const IniReader * const reader,
+	const struct doc_context * const known,
+	struct doc_context * const dest
+) {
+
+	const IniTapeSection root = { 0, 0 };
+
+	const int return_value = store_doc_path(
+		doc,
+		known->parent,
+		reader->curr_parent_str,
+		reader->curr_parent_len,
+		reader->subparent_str,
+		reader->curr_parent_len ? reader->subparent_len : 0,
+		&dest->parent
+	);
+
+	dest->parent_is_disabled = reader->parent_is_disabled;
+
+	if (return_value || !reader->parent_is_disabled) {
+
+		dest->real_parent = root;
+		return return_value;
+
+	}
+
+	return store_doc_path(
+		doc,
+		known->real_parent,
+		reader->real_parent_str,
+		reader->real_parent_len,
+		(const char *) 0,
+		0,
+		&dest->real_parent
+	);
+
+}
+
+
+/**
+
+	@brief          Give a pull-style parser the section context of a segment
+	@param          builder         The tape whose `parents` buffers will hold
+	                                the paths
+	@param          reader          The state of the parser
+	@param          doc             The document
+	@param          context         The context to restore
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+**/
+static int load_doc_context (
+	struct tape_builder * const builder,
+	IniReader * const reader,
+	const IniDocument * const doc,
+	const struct doc_context * const context
+) {
+
+	const IniTapeSection paths[2] = { context->parent, context->real_parent };
+	size_t slot, idx;
+	int return_value;
+
+	for (slot = 0; slot < 2; slot++) {
+
+		if (
+			(return_value = grow_buffer(
+				builder->parents + slot,
+				builder->parents_size + slot,
+				paths[slot].len + 1
+			))
+		) {
+
+			return return_value;
+
+		}
+
+		for (idx = 0; idx <= paths[slot].len; idx++) {
+
+			builder->parents[slot][idx] = doc->paths[paths[slot].offs + idx];
+
+		}
+
+	}
+
+	reader->curr_parent_str = builder->parents[0];
+	reader->curr_parent_len = context->parent.len;
+	reader->subparent_str = builder->parents[0] + context->parent.len;
+	reader->subparent_len = 0;
+	reader->real_parent_str = builder->parents[1];
+	reader->real_parent_len = context->real_parent.len;
+	reader->parent_is_disabled = context->parent_is_disabled;
+
+	return CONFINI_SUCCESS;
+
+}
+
+
+/**
+
+	@brief          Parse a group of consecutive segments of a document
+	@param          doc             The document
+	@param          parse           The parse where to append the segments and
+	                                their nodes
+	@param          src             The text of the segments
+	@param          len             The length of @p src
+	@param          at              The offset of @p src in the document
+	@param          is_last         Whether @p src reaches the end of the
+	                                document
+	@param          context         The section context before the first
+	                                segment, replaced with the context after the
+	                                last one
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	The segments are tokenized as #tokenize_ini_cache() would tokenize them.
+	@p src must begin at the beginning of a segment and, unless @p is_last is
+	`true`, end at the end of a segment.
+
+**/
+static int parse_doc_region (
+	IniDocument * const doc,
+	struct doc_parse * const parse,
+	const char * const src,
+	const size_t len,
+	const size_t at,
+	const _CONFINI_CHARBOOL_ is_last,
+	struct doc_context * const context
+) {
+
+	const size_t copy_at = parse->region_len;
+	struct doc_segment * segment;
+	size_t idx, seg_at = 0;
+	int return_value;
+
+	if (
+		(return_value = grow_buffer(
+			&parse->region,
+			&parse->region_size,
+			copy_at + len + 1
+		))
+	) {
+
+		return return_value;
+
+	}
+
+	for (idx = 0; idx < len; idx++) {
+
+		parse->region[copy_at + idx] = src[idx];
+
+	}
+
+	parse->region_len += len + 1;
+
+	IniReader reader = ini_reader_init(parse->region + copy_at, len, doc->format);
+
+	if (at) {
+
+		/*  A BOM can only be found at the beginning of the document  */
+		reader.scan_at = 0;
+		reader.lshift = 0;
+
+	}
+
+	if (
+		(return_value = load_doc_context(&parse->builder, &reader, doc, context))
+	) {
+
+		return return_value;
+
+	}
+
+	for (;;) {
+
+		if (seg_at) {
+
+			/*  The context after the previous segment  */
+
+			if (
+				(return_value = store_doc_context(doc, &reader, context, context))
+			) {
+
+				return return_value;
+
+			}
+
+			if (seg_at == len && !is_last) {
+
+				/*  The next segment does not belong to this group  */
+				break;
+
+			}
+
+		}
+
+		if (!read_ini_segment(&reader)) {
+
+			break;
+
+		}
+
+		if (
+			(return_value = grow_buffer(
+				&parse->segments,
+				&parse->segments_size,
+				(parse->n_segments + 1) * sizeof(struct doc_segment)
+			))
+		) {
+
+			return return_value;
+
+		}
+
+		segment = (struct doc_segment *) parse->segments + parse->n_segments++;
+		segment->at = at + seg_at;
+		segment->n_nodes = 0;
+		segment->context = *context;
+
+		for (;;) {
+
+			if (
+				(return_value = move_tape_parent(&parse->builder, &reader))
+			) {
+
+				return return_value;
+
+			}
+
+			if (!next_ini_node(&reader, &reader.node_at, reader.seg_end)) {
+
+				break;
+
+			}
+
+			if (reader.next_id++ >= reader.max_id) {
+
+				return CONFINI_EOOR;
+
+			}
+
+			if (
+				(return_value = add_tape_record(
+					&parse->builder,
+					&reader.dispatch,
+					parse->region
+				))
+			) {
+
+				return return_value;
+
+			}
+
+			segment->n_nodes++;
+
+		}
+
+		seg_at = reader.scan_at;
+
+	}
+
+	return CONFINI_SUCCESS;
+
+}
+
+
+/**
+
+	@brief          Initialize a #doc_parse structure
+	@param          parse           The structure to initialize
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	The structure must be freed with #free_doc_parse() even if this function
+	fails.
+
+**/
+static int start_doc_parse (
+	struct doc_parse * const parse
+) {
+
+	parse->region = (char *) 0;
+	parse->segments = (char *) 0;
+	parse->region_len = 0;
+	parse->region_size = 0;
+	parse->n_segments = 0;
+	parse->segments_size = 0;
+
+	return start_tape_builder(&parse->builder);
+
+}
+
+
+/**
+
+	@brief          Free the buffers of a #doc_parse structure
+	@param          parse           The parse to free
+	@return         Nothing
+
+**/
+static void free_doc_parse (
+	struct doc_parse * const parse
+) {
+
+	free(parse->builder.records);
+	free(parse->builder.sections);
+	free(parse->builder.paths);
+	free(parse->builder.parents[0]);
+	free(parse->builder.parents[1]);
+	free(parse->region);
+	free(parse->segments);
+
+}
+
+
+/**
+
+	@brief          Check whether two strings of two parses are equal
+	@param          str_a           The first string
+	@param          len_a           The length of @p str_a
+	@param          str_b           The second string
+	@param          len_b           The length of @p str_b
+	@return         A boolean
+
+**/
+static _CONFINI_CHARBOOL_ doc_strings_equal (
+	const char * const str_a,
+	const size_t len_a,
+	const char * const str_b,
+	const size_t len_b
+) {
+
+	if (len_a != len_b) {
+
+		return _CONFINI_FALSE_;
+
+	}
+
+	for (size_t idx = 0; idx < len_a; idx++) {
+
+		if (str_a[idx] != str_b[idx]) {
+
+			return _CONFINI_FALSE_;
+
+		}
+
+	}
+
+	return _CONFINI_TRUE_;
+
+}
+
+
+/**
+
+	@brief          Check whether two section contexts of a document are equal
+	@param          doc             The document
+	@param          context_a       The first context
+	@param          context_b       The second context
+	@return         A boolean
+
+**/
+static _CONFINI_CHARBOOL_ doc_contexts_equal (
+	const IniDocument * const doc,
+	const struct doc_context * const context_a,
+	const struct doc_context * const context_b
+) {
+
+	return
+		context_a->parent_is_disabled == context_b->parent_is_disabled &&
+		doc_strings_equal(
+			doc->paths + context_a->parent.offs,
+			context_a->parent.len,
+			doc->paths + context_b->parent.offs,
+			context_b->parent.len
+		) && (
+			!context_a->parent_is_disabled || doc_strings_equal(
+				doc->paths + context_a->real_parent.offs,
+				context_a->real_parent.len,
+				doc->paths + context_b->real_parent.offs,
+				context_b->real_parent.len
+			)
+		);
+
+}
+
+
+/**
+
+	@brief          Replace a range of the text of a document
+	@param          doc             The document
+	@param          edit_at         The offset of the range
+	@param          old_len         The length of the range
+	@param          new_text        The text that replaces the range
+	@param          new_len         The length of @p new_text
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	If the text does not grow this function cannot fail.
+
+**/
+static int splice_doc_text (
+	IniDocument * const doc,
+	const size_t edit_at,
+	const size_t old_len,
+	const char * const new_text,
+	const size_t new_len
+) {
+
+	const size_t new_text_len = doc->text_len - old_len + new_len;
+	size_t idx;
+
+	const int grow_err =
+		grow_buffer(&doc->text, &doc->text_size, new_text_len + 1);
+
+	if (grow_err) {
+
+		return grow_err;
+
+	}
+
+	if (new_len > old_len) {
+
+		for (idx = doc->text_len; idx > edit_at + old_len; idx--) {
+
+			doc->text[idx - old_len + new_len - 1] = doc->text[idx - 1];
+
+		}
+
+	} else if (new_len < old_len) {
+
+		for (idx = edit_at + old_len; idx < doc->text_len; idx++) {
+
+			doc->text[idx - old_len + new_len] = doc->text[idx];
+
+		}
+
+	}
+
+	for (idx = 0; idx < new_len; idx++) {
+
+		doc->text[edit_at + idx] = new_text[idx];
+
+	}
+
+	doc->text_len = new_text_len;
+
+	return CONFINI_SUCCESS;
+
+}
+
+
+/**
+
+	@brief          Check whether two nodes of two parses would be dispatched
+	                identically (apart from their `dispatch_id`)
+	@param          parse_a         The parse of the first node
+	@param          node_a          The number of the first node
+	@param          parse_b         The parse of the second node
+	@param          node_b          The number of the second node
+	@return         A boolean
+
+**/
+static _CONFINI_CHARBOOL_ doc_nodes_equal (
+	const struct doc_parse * const parse_a,
+	const size_t node_a,
+	const struct doc_parse * const parse_b,
+	const size_t node_b
+) {
+
+	const IniTapeRecord
+		* const rec_a = (const IniTapeRecord *) parse_a->builder.records + node_a,
+		* const rec_b = (const IniTapeRecord *) parse_b->builder.records + node_b;
+
+	const IniTapeSection
+		* const at_a =
+			(const IniTapeSection *) parse_a->builder.sections + rec_a->section,
+		* const at_b =
+			(const IniTapeSection *) parse_b->builder.sections + rec_b->section;
+
+	return
+		rec_a->type == rec_b->type &&
+		doc_strings_equal(
+			parse_a->region + rec_a->d_offs,
+			rec_a->d_len,
+			parse_b->region + rec_b->d_offs,
+			rec_b->d_len
+		) && (
+			rec_a->v_offs >= INI_TAPE_IMPLICIT_VALUE ||
+			rec_b->v_offs >= INI_TAPE_IMPLICIT_VALUE ?
+				rec_a->v_offs == rec_b->v_offs && rec_a->v_len == rec_b->v_len
+			:
+				doc_strings_equal(
+					parse_a->region + rec_a->v_offs,
+					rec_a->v_len,
+					parse_b->region + rec_b->v_offs,
+					rec_b->v_len
+				)
+		) &&
+		doc_strings_equal(
+			parse_a->builder.paths + at_a->offs,
+			at_a->len,
+			parse_b->builder.paths + at_b->offs,
+			at_b->len
+		);
+
+}
+
+
+/**
+
+	@brief          Invoke the callback of #ini_document_edit() for a node
+	@param          doc             The document
+	@param          parse           The parse of the node
+	@param          node_num        The number of the node within @p parse
+	@param          dispatch_id     The position of the node in the document
+	@param          change          The change (see `enum` #IniDeltaType)
+	@param          f_delta         The callback
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, non-zero if the callback interrupted the
+	                document
+
+**/
+static int dispatch_doc_node (
+	const IniDocument * const doc,
+	const struct doc_parse * const parse,
+	const size_t node_num,
+	const size_t dispatch_id,
+	const int change,
+	const IniDeltaHandler f_delta,
+	void * const user_data
+) {
+
+	const IniTapeRecord * const record =
+		(const IniTapeRecord *) parse->builder.records + node_num;
+
+	const IniTapeSection * const section =
+		(const IniTapeSection *) parse->builder.sections + record->section;
+
+	IniDispatch dispatch = {
+		.format = doc->format,
+		.type = record->type,
+		.data = parse->region + record->d_offs,
+		.value =
+			record->v_offs == INI_TAPE_NO_VALUE ?
+				(char *) 0
+			: record->v_offs == INI_TAPE_IMPLICIT_VALUE ?
+				INI_GLOBAL_IMPLICIT_VALUE
+			:
+				parse->region + record->v_offs,
+		.append_to = parse->builder.paths + section->offs,
+		.d_len = record->d_len,
+		.v_len = record->v_len,
+		.at_len = section->len,
+		.dispatch_id = dispatch_id
+	};
+
+	return f_delta(&dispatch, change, user_data);
+
+}
+
+
+/**
+
+	@brief          Invoke the callback of #ini_document_edit() for each node that
+	                differs between two parses of the same part of a document
+	@param          doc             The document
+	@param          old_parse       The parse before the edit
+	@param          new_parse       The parse after the edit
+	@param          first_id        The position in the document of the first
+	                                node of both parses
+	@param          f_delta         The callback
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	The nodes that the two parses have in common at the beginning and at the end
+	are skipped. Of the others, as many as possible are paired and reported as
+	changed, unless the two nodes of a pair are identical, then the surplus is
+	reported as removed or added.
+
+**/
+static int dispatch_doc_delta (
+	const IniDocument * const doc,
+	const struct doc_parse * const old_parse,
+	const struct doc_parse * const new_parse,
+	size_t first_id,
+	const IniDeltaHandler f_delta,
+	void * const user_data
+) {
+
+	size_t
+		old_end = old_parse->builder.n_records,
+		new_end = new_parse->builder.n_records,
+		old_at = 0,
+		new_at = 0;
+
+	while (
+		old_at < old_end && new_at < new_end &&
+		doc_nodes_equal(old_parse, old_at, new_parse, new_at)
+	) {
+
+		old_at++;
+		new_at++;
+
+	}
+
+	while (
+		old_end > old_at && new_end > new_at &&
+		doc_nodes_equal(old_parse, old_end - 1, new_parse, new_end - 1)
+	) {
+
+		old_end--;
+		new_end--;
+
+	}
+
+	first_id += new_at;
+
+	for (; old_at < old_end && new_at < new_end; old_at++, new_at++) {
+
+		/*  For instance a comment between a renamed section and its keys  */
+		if (
+			!doc_nodes_equal(old_parse, old_at, new_parse, new_at) &&
+			dispatch_doc_node(
+				doc,
+				new_parse,
+				new_at,
+				first_id,
+				INI_DELTA_CHANGED,
+				f_delta,
+				user_data
+			)
+		) {
+
+			return CONFINI_FEINTR;
+
+		}
+
+		first_id++;
+
+	}
+
+	for (; old_at < old_end; old_at++) {
+
+		if (
+			dispatch_doc_node(
+				doc,
+				old_parse,
+				old_at,
+				first_id,
+				INI_DELTA_REMOVED,
+				f_delta,
+				user_data
+			)
+		) {
+
+			return CONFINI_FEINTR;
+
+		}
+
+	}
+
+	for (; new_at < new_end; new_at++) {
+
+		if (
+			dispatch_doc_node(
+				doc,
+				new_parse,
+				new_at,
+				first_id++,
+				INI_DELTA_ADDED,
+				f_delta,
+				user_data
+			)
+		) {
+
+			return CONFINI_FEINTR;
+
+		}
+
+	}
+
+	return CONFINI_SUCCESS;
+
+}
+
+
+
+
+/** @startfnlist **/
+
+
+
+		/*\
+		|*|
+		|*|     GLOBAL ENVIRONMENT
+		|*|    ________________________________
+		\*/
+
+
+
+		/*  LIBRARY'S MAIN FUNCTIONS  */
+
+
+                                                   /** @utility{strip_ini_cache} **/
+/**
+
+	@brief          Parse and tokenize a buffer containing an INI file, then
+	                dispatch its content to a custom callback
+	@param          ini_source      The buffer containing the INI file to tokenize
+	@param          ini_length      The length of @p ini_source without counting the
+	                                NUL terminator (if any -- se below)
+	@param          format          The format of the INI file
+	@param          f_init          The function that will be invoked before the
+	                                first dispatch, or `NULL`
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	The @p ini_source parameter must be a valid pointer to a buffer of size
+	@p ini_length + 1 and cannot be `NULL`. The @p ini_source string does not need
+	to be NUL-terminated, but _it does need one extra byte where to append a NUL
+	terminator_ -- in fact, as soon as this function is invoked,
+	`ini_source[ini_length]` will be immediately set to `\0`.
+
+	In most cases, as when using `strlen()` for computing @p ini_length, this is not
+	a concern, since `ini_source[ini_length]` will always be `\0` by the very
+	definition of `strlen()`, and will only get overwritten with the same value.
+	However, if you are passing a substring of a string, for example the fragment
+	`foo=bar` of the string `foo=barracuda`, you must expect the string to be
+	immediately truncated into `foo=bar\0acuda`.
+
+	In other words, @p ini_source must point to a memory location where at least
+	`ini_length + 1` bytes are freely usable.
+
+	The user given function @p f_init (see #IniStatsHandler data type) will be
+	invoked with two arguments: `statistics` (a pointer to an #IniStatistics
+	structure containing some properties about the file read) and `user_data` (the
+	custom argument @p user_data previously passed). If @p f_init returns a non-zero
+	value the caller function will be interrupted.
+
+	The user given function @p f_foreach (see #IniDispHandler data type) will be
+	invoked with two arguments: `dispatch` (a pointer to an #IniDispatch structure
+	containing the parsed member of the INI file) and `user_data` (the custom
+	argument @p user_data previously passed). If @p f_foreach returns a non-zero
+	value the caller function will be interrupted.
+
+	When @p f_init is `NULL` the buffer is parsed in a single pass, and each line
+	is dispatched as soon as it has been tokenized; otherwise the whole buffer is
+	tokenized before @p f_init is invoked and the first dispatch takes place. In
+	both cases the dispatches are the same.
+
+	After invoking `strip_ini_cache()`, the buffer pointed by the @p ini_source
+	parameter must be considered as a _corrupted buffer_ and should be freed or
+	overwritten. For more information about this function, please refer to the
+	@ref libconfini.
+
+	The parsing algorithms used by **libconfini** are able to parse any type of file
+	encoded in 8-bit code units, as long as the characters that match the regular
+	expression `/[\s\[\]\.\\;#"']/` refer to the same code points they refer to in
+	ASCII (as they do, for example, in UTF-8 and ISO-8859-1), independently of
+	platform-specific conventions.
+
+	@note   In order to be null-byte-injection-safe, before dispatching the parsed
+	        content this function strips all `NUL` characters possibly present in
+	        the buffer (with the exception of the last one).
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_IINTR, #CONFINI_FEINTR,
+	#CONFINI_EOOR.
+
+	@include topics/strip_ini_cache.c
+
+**/
+int strip_ini_cache (
+	register char * const ini_source,
+	const size_t ini_length,
+	const IniFormat format,
+	const IniStatsHandler f_init,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	return strip_ini_cache_with_options(
+		ini_source,
+		ini_length,
+		format,
+		(const IniParseOptions *) 0,
+		f_init,
+		f_foreach,
+		user_data
+	);
+
+}
+
+
+                                      /** @utility{strip_ini_cache_with_options} **/
+/**
+
+	@brief          Parse and tokenize a buffer containing an INI file, using a
+	                custom implicit value and lowercase mode
+	@param          ini_source      The buffer containing the INI file to tokenize
+	@param          ini_length      The length of @p ini_source without counting the
+	                                NUL terminator (if any -- see #strip_ini_cache())
+	@param          format          The format of the INI file
+	@param          options         The implicit value and the lowercase mode, or
+	                                `NULL` for using #INI_GLOBAL_IMPLICIT_VALUE,
+	                                #INI_GLOBAL_IMPLICIT_V_LEN and
+	                                #INI_GLOBAL_LOWERCASE_MODE
+	@param          f_init          The function that will be invoked before the
+	                                first dispatch, or `NULL`
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	This function behaves like #strip_ini_cache(), but keys without a value get
+	`options->implicit_value` and `options->implicit_v_len` as their value (in
+	formats where #IniFormat::implicit_is_not_empty is set), and key and section
+	names in case-insensitive formats are dispatched lowercase if
+	`options->lowercase_mode` is `true`. The global variables are never read, so
+	different threads can parse different buffers with different options at the
+	same time, without any locking.
+
+	The @p options structure is not copied and must remain valid until the
+	function returns. Unlike #INI_GLOBAL_IMPLICIT_VALUE, `options->implicit_value`
+	is not recognized by #ini_unquote(), #ini_string_parse() and the other
+	functions that parse INI strings, which may therefore modify it when it
+	contains quotes, escape sequences or consecutive spaces.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_IINTR, #CONFINI_FEINTR,
+	#CONFINI_EOOR.
+
+**/
+int strip_ini_cache_with_options (
+	register char * const ini_source,
+	const size_t ini_length,
+	const IniFormat format,
+	const IniParseOptions * const options,
+	const IniStatsHandler f_init,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	#ifdef CONFINI_SPECIALIZED_FORMATS
+
+	#define __FORMAT_CASE__(FORMAT_NUM) \
+		case FORMAT_NUM: \
+			return strip_ini_cache_##FORMAT_NUM( \
+				ini_source, \
+				ini_length, \
+				options, \
+				f_init, \
+				f_foreach, \
+				user_data \
+			);
+
+	switch (ini_fton(format)) {
+
+		_CONFINI_FOR_EACH_(__FORMAT_CASE__, CONFINI_SPECIALIZED_FORMATS)
+
+	}
+
+	#undef __FORMAT_CASE__
+
+	#endif
+
+	return tokenize_ini_cache(
+		ini_source,
+		ini_length,
+		format,
+		options,
+		f_init,
+		f_foreach,
+		user_data
+	);
+
+}
+
+
+                                                   /** @utility{ini_reader_init} **/
+/**
+
+	@brief          Prepare a pull-style parser for a buffer containing an INI
+	                file
+	@param          ini_source      The buffer containing the INI file to tokenize
+	@param          ini_length      The length of @p ini_source without counting the
+	                                NUL terminator (if any -- se below)
+	@param          format          The format of the INI file
+	@return         The state of the parser, to be passed to #ini_reader_next()
+
+	The @p ini_source and @p ini_length parameters have the same constraints as in
+	#strip_ini_cache(): `ini_source[ini_length]` is immediately set to `\0`, and
+	the buffer is tokenized and rearranged while its nodes are read.
+
+	No memory is allocated and nothing is parsed by this function: each call to
+	#ini_reader_next() tokenizes only what it needs in order to return the next
+	node. The returned structure must be used to initialize a variable, as in
+
+	~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+	IniReader reader = ini_reader_init(my_buffer, my_length, my_format);
+	~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+	since the `const` members of #IniDispatch do not allow to assign it.
+
+**/
+IniReader ini_reader_init (
+	char * const ini_source,
+	const size_t ini_length,
+	const IniFormat format
+) {
+
+	ini_source[ini_length] = '\0';
+
+	/*  UTF-8 BOM  */
+	const size_t bom_len =
+		*((unsigned char *) ini_source) == 0xEF &&
+		*((unsigned char *) ini_source + 1) == 0xBB &&
+		*((unsigned char *) ini_source + 2) == 0xBF
+		? 3 : 0;
+
+	return (IniReader) {
+		.dispatch = {
+			.format = format,
+			.dispatch_id = 0
+		},
+		.ini_source = ini_source,
+		.curr_parent_str = ini_source + ini_length,
+		.subparent_str = ini_source + ini_length,
+		.real_parent_str = ini_source + ini_length,
+		.ini_length = ini_length,
+		.scan_at = bom_len,
+		.lshift = bom_len,
+		.seg_at = 0,
+		.seg_end = 0,
+		.node_at = 1,
+		.max_id = 0,
+		.next_id = 0,
+		.curr_parent_len = 0,
+		.subparent_len = 0,
+		.real_parent_len = 0,
+		.interest = (const IniInterestSet *) 0,
+		.options = (const IniParseOptions *) 0,
+		.checked_parent_str = (const char *) 0,
+		.checked_parent_len = 0,
+		.status = CONFINI_SUCCESS,
+		.eol_n = _CONFINI_EOL_IDX_,
+		.isnt_escaped = _CONFINI_TRUE_,
+		.parent_is_disabled = _CONFINI_FALSE_,
+		.parent_is_wanted = _CONFINI_FALSE_,
+		.valid_delimiter = !_CONFINI_IS_ESC_CHAR_(format.delimiter_symbol, format),
+		.value_is_raw = _CONFINI_FALSE_
+	};
+
+}
+
+
+                                                   /** @utility{ini_reader_next} **/
+/**
+
+	@brief          Read the next node of a buffer containing an INI file
+	@param          reader          The state of the parser, as returned by
+	                                #ini_reader_init()
+	@param          dispatch        The address where a pointer to the dispatch
+	                                of the node will be stored
+	@return         Zero for success, #CONFINI_EOF if there are no more nodes,
+	                otherwise an error code (see `enum` #ConfiniInterruptNo)
+
+	This is the pull-style counterpart of #strip_ini_cache(): instead of invoking
+	a callback for each node, the caller asks for the nodes one by one, and can
+	stop whenever it wants -- or resume later -- without returning any value from a
+	callback. The nodes read are the same that #strip_ini_cache() would dispatch,
+	and each call tokenizes only the line (or the group of lines joined by escaped
+	line breaks) that contains the next node.
+
+	The dispatch is stored in @p reader itself and remains valid only until the
+	next call, which may overwrite it. As with #strip_ini_cache(), its content can
+	be edited, but its `dispatch_id` is overwritten by each call and the buffer
+	must be regarded as corrupted after the last node has been read.
+
+	Once a non-zero value has been returned, all subsequent calls return the same
+	value and leave @p dispatch untouched.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_EOF, #CONFINI_EOOR.
+
+	@include topics/ini_reader_next.c
+
+**/
+int ini_reader_next (
+	IniReader * const reader,
+	IniDispatch ** const dispatch
+) {
+
+	if (reader->status || (reader->status = pull_ini_node(reader))) {
+
+		return reader->status;
+
+	}
+
+	*dispatch = &reader->dispatch;
+
+	return CONFINI_SUCCESS;
+
+}
+
+
+                                           /** @utility{ini_reader_set_interest} **/
+/**
+
+	@brief          Restrict the nodes read by a pull-style parser to some node
+	                types, sections and keys
+	@param          reader          The state of the parser, as returned by
+	                                #ini_reader_init()
+	@param          interest        The node types, the sections and the keys to
+	                                read, or `NULL` for reading everything
+	@return         Nothing
+
+	The node types, sections and keys of @p interest are independent filters, and
+	a node is returned only if it passes all of them:
+
+	- `interest->node_types` is a mask of the node types to read, built with
+	  #INI_NODE_MASK() -- for instance
+	  `INI_NODE_MASK(INI_KEY) | INI_NODE_MASK(INI_SECTION)`; zero selects all
+	  types
+	- `interest->sections` is a list of section paths: the nodes that belong to
+	  any other section are not read (section nodes themselves are not subject to
+	  this filter); the root section has an empty path
+	- `interest->keys` is a list of key names: the keys and the disabled keys with
+	  any other name are not read (other nodes are not subject to this filter)
+
+	If `interest->lazy_values` is `true` the values of the keys read are not
+	normalized, but left raw until #ini_dispatch_value() is invoked.
+
+	Section paths and key names are compared as #ini_string_match_si() would
+	compare them, and an empty list matches everything.
+
+	Unwanted nodes are classified, but never normalized, so the more nodes are
+	filtered out, the faster the parsing. Section nodes are always parsed, even
+	when they are not read, so that the #IniDispatch::append_to field of the
+	other nodes and the scope of disabled sections are never affected. The
+	dispatch IDs count only the nodes read.
+
+	The @p interest structure and the strings it points to are not copied, and
+	must remain valid as long as the parser is used. The interest set can be
+	changed at any moment, and affects only the nodes that have not been read yet.
+
+**/
+void ini_reader_set_interest (
+	IniReader * const reader,
+	const IniInterestSet * const interest
+) {
+
+	reader->interest = interest;
+	reader->checked_parent_str = (const char *) 0;
+
+}
+
+
+                                             /** @utility{ini_reader_set_options} **/
+/**
+
+	@brief          Set the implicit value and the lowercase mode of a pull-style
+	                parser
+	@param          reader          The state of the parser, as returned by
+	                                #ini_reader_init()
+	@param          options         The implicit value and the lowercase mode, or
+	                                `NULL` for using the global ones
+	@return         Nothing
+
+	The nodes read afterwards are normalized as #strip_ini_cache_with_options()
+	would normalize them. The @p options structure is not copied, and must remain
+	valid as long as the parser is used.
+
+**/
+void ini_reader_set_options (
+	IniReader * const reader,
+	const IniParseOptions * const options
+) {
+
+	reader->options = options;
+
+}
+
+
+                                          /** @utility{strip_ini_cache_filtered} **/
+/**
+
+	@brief          Parse and tokenize a buffer containing an INI file, then
+	                dispatch only some of its nodes to a custom callback
+	@param          ini_source      The buffer containing the INI file to tokenize
+	@param          ini_length      The length of @p ini_source without counting the
+	                                NUL terminator (if any -- see #strip_ini_cache())
+	@param          format          The format of the INI file
+	@param          interest        The node types, the sections and the keys to
+	                                dispatch, or `NULL` for dispatching everything
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	This function behaves like #strip_ini_cache() without an `f_init` callback,
+	but dispatches only the nodes selected by @p interest, with the rules
+	described in #ini_reader_set_interest().
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_FEINTR, #CONFINI_EOOR.
+
+**/
+int strip_ini_cache_filtered (
+	register char * const ini_source,
+	const size_t ini_length,
+	const IniFormat format,
+	const IniInterestSet * const interest,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	IniReader reader = ini_reader_init(ini_source, ini_length, format);
+	int return_value;
+
+	reader.interest = interest;
+
+	while (!(return_value = pull_ini_node(&reader))) {
+
+		if (f_foreach(&reader.dispatch, user_data)) {
+
+			return CONFINI_FEINTR;
+
+		}
+
+	}
+
+	return return_value == CONFINI_EOF ? CONFINI_SUCCESS : return_value;
+
+}
+
+
+                                                /** @utility{ini_dispatch_value} **/
+/**
+
+	@brief          Get the value of a dispatch of a pull-style parser,
+	                normalizing it first if it has been dispatched raw
+	@param          dispatch        The dispatch, as returned by
+	                                #ini_reader_next() or as passed to the
+	                                callback of #strip_ini_cache_filtered()
+	@return         The normalized value, which is also stored in
+	                `dispatch->value`
+
+	When #IniInterestSet::lazy_values is set, the values of the keys are
+	dispatched as they appear in the buffer, and the parser remembers that the
+	value of its current dispatch is raw. This function applies to such a value
+	exactly the normalization that the format would have applied, updates the
+	`value` and `v_len` fields of @p dispatch, and returns the new value. It does
+	nothing when the value has already been normalized, so it can be invoked any
+	number of times.
+
+	Since the state of the value belongs to the parser and not to the dispatch,
+	@p dispatch must be the #IniReader::dispatch member of a parser, and never a
+	copy of it or the dispatch of another function. As all the other strings
+	dispatched, a raw value is valid only until the next dispatch, and so is the
+	possibility to normalize it.
+
+**/
+char * ini_dispatch_value (
+	IniDispatch * const dispatch
+) {
+
+	/*  The dispatch is the first member of its parser  */
+	IniReader * const reader = (IniReader *) dispatch;
+
+	if (reader->value_is_raw) {
+
+		normalize_value(dispatch);
+		reader->value_is_raw = _CONFINI_FALSE_;
+
+	}
+
+	return dispatch->value;
+
+}
+
+
+                                                   /** @utility{ini_stream_open} **/
+/**
+
+	@brief          Create a push-style streaming parser
+	@param          format          The format of the INI file
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         A new streaming parser, or `NULL` if there was not enough
+	                memory
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	A streaming parser receives an INI file in chunks of any size through
+	#ini_stream_feed(), and dispatches each node to @p f_foreach as soon as the
+	node is complete. Only the current segment (a single line, or a multi-line
+	group of lines joined by escaped line breaks) and the current section path
+	are kept in memory, so that the memory used does not depend on the size of the
+	file, but only on the size of its longest segment.
+
+	The dispatches produced are identical to those produced by #strip_ini_cache()
+	when parsing the whole file at once, but since the file is never seen as a
+	whole no #IniStatistics structure is ever produced.
+
+	The parser must be destroyed using #ini_stream_close() after the last chunk
+	has been fed.
+
+	@include topics/ini_stream_feed.c
+
+**/
+IniStream * ini_stream_open (
+	const IniFormat format,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	IniStream * const stream = (IniStream *) malloc(sizeof(IniStream));
+
+	if (!stream) {
+
+		return (IniStream *) 0;
+
+	}
+
+	stream->segment = (char *) malloc(_CONFINI_STREAM_SEGSIZE_);
+	stream->path = (char *) malloc(_CONFINI_STREAM_PATHSIZE_);
+
+	if (!stream->segment || !stream->path) {
+
+		free(stream->path);
+		free(stream->segment);
+		free(stream);
+		return (IniStream *) 0;
+
+	}
+
+	reset_stream(stream, f_foreach, user_data);
+	stream->format = format;
+	stream->options = (const IniParseOptions *) 0;
+	stream->seg_size = _CONFINI_STREAM_SEGSIZE_;
+	stream->path_size = _CONFINI_STREAM_PATHSIZE_;
+	stream->valid_delimiter =
+		!_CONFINI_IS_ESC_CHAR_(format.delimiter_symbol, format);
+
+	return stream;
+
+}
+
+
+                                            /** @utility{ini_stream_set_options} **/
+/**
+
+	@brief          Set the implicit value and the lowercase mode of a streaming
+	                parser
+	@param          stream          The streaming parser
+	@param          options         The implicit value and the lowercase mode, or
+	                                `NULL` for using the global ones
+	@return         Nothing
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	The nodes dispatched afterwards are normalized as
+	#strip_ini_cache_with_options() would normalize them. The @p options
+	structure is not copied, and must remain valid until the parser is closed.
+
+**/
+void ini_stream_set_options (
+	IniStream * const stream,
+	const IniParseOptions * const options
+) {
+
+	stream->options = options;
+
+}
+
+
+                                                   /** @utility{ini_stream_feed} **/
+/**
+
+	@brief          Feed a streaming parser with a chunk of an INI file
+	@param          stream          The streaming parser
+	@param          chunk           The next chunk of the INI file
+	@param          chunk_len       The length of @p chunk
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	The chunks can be of any size and can be split anywhere, even in the middle of
+	a line or of a line break; @p chunk is only read and can be reused as soon as
+	the function returns. All the nodes that have been completed by @p chunk are
+	dispatched before returning. The last node of the file is dispatched only by
+	#ini_stream_close().
+
+	As with #strip_ini_cache(), the dispatched strings belong to the parser and
+	must be copied if they are needed after the dispatch.
+
+	Once this function has returned a non-zero value, the parser stops parsing and
+	all subsequent calls return the same value.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_FEINTR,
+	#CONFINI_ENOMEM, #CONFINI_EOOR, #CONFINI_EFBIG.
+
+**/
+int ini_stream_feed (
+	IniStream * const stream,
+	const char * const chunk,
+	const size_t chunk_len
+) {
+
+	static const unsigned char utf8_bom[3] = { 0xEF, 0xBB, 0xBF };
+
+	if (stream->status) {
+
+		return stream->status;
+
+	}
+
+	for (size_t idx = 0; idx < chunk_len; idx++) {
+
+		if (
+			stream->seg_len + 2 > stream->seg_size &&
+			(stream->status = grow_buffer(
+				&stream->segment,
+				&stream->seg_size,
+				stream->seg_len + 2
+			))
+		) {
+
+			return stream->status;
+
+		}
+
+		if (stream->pair_is_pending) {
+
+			/*  The second character of an escaped CR + LF or LF + CR sequence  */
+
+			stream->pair_is_pending = _CONFINI_FALSE_;
+
+			if (chunk[idx] == _CONFINI_SPACES_[stream->eol_n ^ 1]) {
+
+				stream->segment[stream->seg_len++] = chunk[idx];
+				continue;
+
+			}
+
+		}
+
+		if (stream->bom_at < 3) {
+
+			/*  UTF-8 BOM  */
+
+			if (((const unsigned char *) chunk)[idx] != utf8_bom[stream->bom_at]) {
+
+				stream->bom_at = 3;
+
+			} else if (++stream->bom_at == 3) {
+
+				stream->seg_len = 0;
+				continue;
+
+			}
+
+		}
+
+		if (
+			chunk[idx] == _CONFINI_SPACES_[stream->eol_n] ||
+			chunk[idx] == _CONFINI_SPACES_[stream->eol_n ^= 1]
+		) {
+
+			if (
+				stream->format.multiline_nodes == INI_NO_MULTILINE ||
+				stream->isnt_escaped
+			) {
+
+				if ((stream->status = flush_stream_segment(stream))) {
+
+					return stream->status;
+
+				}
+
+			} else {
+
+				stream->segment[stream->seg_len++] = chunk[idx];
+				stream->pair_is_pending = _CONFINI_TRUE_;
+
+			}
+
+			stream->isnt_escaped = _CONFINI_TRUE_;
+
+		} else if (chunk[idx] == _CONFINI_BACKSLASH_) {
+
+			stream->segment[stream->seg_len++] = chunk[idx];
+			stream->isnt_escaped = !stream->isnt_escaped;
+
+		} else if (chunk[idx]) {
+
+			stream->segment[stream->seg_len++] = chunk[idx];
+			stream->isnt_escaped = _CONFINI_TRUE_;
+
+		}
+
+		/*  `NUL` characters are silently dropped  */
+
+	}
+
+	return CONFINI_SUCCESS;
+
+}
+
+
+                                                  /** @utility{ini_stream_close} **/
+/**
+
+	@brief          Dispatch the last node received by a streaming parser, then
+	                destroy the parser
+	@param          stream          The streaming parser to destroy
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	The memory of @p stream is always freed, even when this function fails. If a
+	previous call to #ini_stream_feed() had failed, nothing is dispatched and the
+	same error code is returned again.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_FEINTR,
+	#CONFINI_ENOMEM, #CONFINI_EOOR, #CONFINI_EFBIG.
+
+**/
+int ini_stream_close (
+	IniStream * const stream
+) {
+
+	const int return_value =
+		stream->status ? stream->status : flush_stream_segment(stream);
+
+	free(stream->path);
+	free(stream->segment);
+	free(stream);
+	return return_value;
+
+}
+
+
+                                             /** @utility{strip_ini_const_cache} **/
+/**
+
+	@brief          Parse a read-only buffer containing an INI file, then dispatch
+	                its content to a custom callback
+	@param          ini_source      The buffer containing the INI file to parse
+	@param          ini_length      The length of @p ini_source
+	@param          format          The format of the INI file
+	@param          f_init          The function that will be invoked before the
+	                                first dispatch, or `NULL`
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	This function behaves like #strip_ini_cache(), but never writes to
+	@p ini_source, which therefore can be a string literal, a `const` array, or
+	memory mapped or shared read-only. Neither does @p ini_source need an extra
+	byte for the NUL terminator.
+
+	Each segment of the file (a single line, or a multi-line group of lines joined
+	by escaped line breaks) is copied into a private side buffer and normalized
+	there, together with the current section path. When @p f_init is not `NULL`
+	the file is scanned twice: the first pass counts the members needed for the
+	#IniStatistics structure and grows the side buffer to the size of the longest
+	segment, so that the second pass -- the one that dispatches -- never needs to
+	allocate memory. Either way the memory used depends only on the size of the
+	longest segment and of the longest section path, not on the size of the file.
+
+	The dispatched strings are always NUL-terminated and belong to the side
+	buffer; as with #strip_ini_cache() they must be copied if they are needed
+	after the dispatch.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_IINTR, #CONFINI_FEINTR,
+	#CONFINI_ENOMEM, #CONFINI_EOOR, #CONFINI_EFBIG.
+
+**/
+int strip_ini_const_cache (
+	const char * const ini_source,
+	const size_t ini_length,
+	const IniFormat format,
+	const IniStatsHandler f_init,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	if (!f_init && !f_foreach) {
+
+		return CONFINI_SUCCESS;
+
+	}
+
+	IniStream * const stream =
+		ini_stream_open(format, (IniDispHandler) 0, (void *) 0);
+
+	if (!stream) {
+
+		return CONFINI_ENOMEM;
+
+	}
+
+	int return_value;
+
+	if (f_init) {
+
+		/*  First pass: count the members and grow the side buffer  */
+
+		if (
+			(return_value = ini_stream_feed(stream, ini_source, ini_length)) ||
+			(return_value = flush_stream_segment(stream))
+		) {
+
+			goto free_and_exit;
+
+		}
+
+		IniStatistics this_doc = {
+			.format = format,
+			.bytes = ini_length,
+			.members = stream->dispatch_id
+		};
+
+		if (f_init(&this_doc, user_data)) {
+
+			return_value = CONFINI_IINTR;
+			goto free_and_exit;
+
+		}
+
+	}
+
+	if (f_foreach) {
+
+		reset_stream(stream, f_foreach, user_data);
+
+		if (!(return_value = ini_stream_feed(stream, ini_source, ini_length))) {
+
+			return_value = flush_stream_segment(stream);
+
+		}
+
+	}
+
+
+	/* \                                /\
+	\ */     free_and_exit:            /* \
+	 \/     ______________________     \ */
+
+
+	free(stream->path);
+	free(stream->segment);
+	free(stream);
+	return return_value;
+
+}
+
+
+                                             /** @utility{strip_ini_cache_batch} **/
+/**
+
+	@brief          Parse and tokenize a buffer containing an INI file, then
+	                dispatch its content in blocks to a custom callback
+	@param          ini_source      The buffer containing the INI file to tokenize
+	@param          ini_length      The length of @p ini_source without counting the
+	                                NUL terminator (if any -- see #strip_ini_cache())
+	@param          format          The format of the INI file
+	@param          f_init          The function that will be invoked before the
+	                                first dispatch, or `NULL`
+	@param          f_batch         The function that will be invoked for each
+	                                block of dispatches, or `NULL`
+	@param          batch_size      The maximum number of dispatches per block, or
+	                                zero for #INI_DEFAULT_BATCH_SIZE
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	This function behaves like #strip_ini_cache(), but instead of invoking a
+	callback for each node it collects the dispatches into an array and invokes
+	@p f_batch (see #IniBatchHandler data type) once for each block, with three
+	arguments: `dispatches` (the array), `n_dispatches` (the number of elements
+	in it, never zero) and `user_data`. The array is allocated once and reused for
+	every block. If @p f_batch returns a non-zero value the caller function will
+	be interrupted.
+
+	All the strings of a block remain valid until @p f_batch returns. For this
+	reason a block is delivered earlier than it would be when the next node
+	requires the parser to rewrite the section path, which happens after the first
+	node of a relative section path and within disabled sections. Editing the data
+	of a section in place affects the `append_to` field of the nodes that follow it
+	in the same block.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_IINTR, #CONFINI_FEINTR,
+	#CONFINI_ENOMEM, #CONFINI_EOOR.
+
+**/
+int strip_ini_cache_batch (
+	char * const ini_source,
+	const size_t ini_length,
+	const IniFormat format,
+	const IniStatsHandler f_init,
+	const IniBatchHandler f_batch,
+	size_t batch_size,
+	void * const user_data
+) {
+
+	IniReader reader = ini_reader_init(ini_source, ini_length, format);
+
+	if (f_init) {
+
+		IniStatistics this_doc = {
+			.format = format,
+			.bytes = ini_length,
+			.members = count_ini_nodes(&reader)
+		};
+
+		if (f_init(&this_doc, user_data)) {
+
+			return CONFINI_IINTR;
+
+		}
+
+	}
+
+	if (!f_batch) {
+
+		return CONFINI_SUCCESS;
+
+	}
+
+	if (!batch_size) {
+
+		batch_size = INI_DEFAULT_BATCH_SIZE;
+
+	}
+
+	IniDispatch * const block =
+		batch_size <= SIZE_MAX / sizeof(IniDispatch) ?
+			(IniDispatch *) malloc(batch_size * sizeof(IniDispatch))
+		:
+			(IniDispatch *) 0;
+
+	if (!block) {
+
+		return CONFINI_ENOMEM;
+
+	}
+
+	/*  The block is not a declared object, so its `format` can be written  */
+	for (size_t idx = 0; idx < batch_size; idx++) {
+
+		*((IniFormat *) &block[idx].format) = format;
+
+	}
+
+	size_t n_dispatches = 0;
+	int return_value;
+
+	do {
+
+		if (
+			n_dispatches && (
+				n_dispatches == batch_size ||
+				(reader.curr_parent_len && reader.subparent_len) ||
+				reader.parent_is_disabled
+			)
+		) {
+
+			/*  The next node might overwrite the strings of the block  */
+
+			if (f_batch(block, n_dispatches, user_data)) {
+
+				return_value = CONFINI_FEINTR;
+				goto free_and_exit;
+
+			}
+
+			n_dispatches = 0;
+
+		}
+
+		if (!(return_value = pull_ini_node(&reader))) {
+
+			block[n_dispatches].type = reader.dispatch.type;
+			block[n_dispatches].data = reader.dispatch.data;
+			block[n_dispatches].value = reader.dispatch.value;
+			block[n_dispatches].append_to = reader.dispatch.append_to;
+			block[n_dispatches].d_len = reader.dispatch.d_len;
+			block[n_dispatches].v_len = reader.dispatch.v_len;
+			block[n_dispatches].at_len = reader.dispatch.at_len;
+			block[n_dispatches].dispatch_id = reader.dispatch.dispatch_id;
+			n_dispatches++;
+
+		}
+
+	} while (!return_value);
+
+	if (return_value == CONFINI_EOF) {
+
+		return_value =
+			n_dispatches && f_batch(block, n_dispatches, user_data) ?
+				CONFINI_FEINTR
+			:
+				CONFINI_SUCCESS;
+
+	}
+
+
+	/* \                                /\
+	\ */     free_and_exit:            /* \
+	 \/     ______________________     \ */
+
+
+	free(block);
+	return return_value;
+
+}
+
+
+                                                    /** @utility{ini_tape_build} **/
+/**
+
+	@brief          Parse and tokenize a buffer containing an INI file, and store
+	                the position of each node in a compact tape
+	@param          ini_source      The buffer containing the INI file to tokenize
+	@param          ini_length      The length of @p ini_source without counting the
+	                                NUL terminator (if any -- see #strip_ini_cache())
+	@param          format          The format of the INI file
+	@param          dest            The address where a pointer to the tape will
+	                                be stored
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	Instead of invoking a callback for each node, this function parses the buffer
+	once and stores each dispatch in an #IniTapeRecord -- a fixed-size record
+	containing its type, the index of its section path and the offsets of its
+	data and value -- in the same order in which #strip_ini_cache() would
+	dispatch it. The offsets refer to @p ini_source, which after the call contains
+	the normalized strings of all the nodes and must therefore outlive the tape.
+	The section paths are stored only once for each group of consecutive nodes
+	that share them, in the `paths` member of the tape. A record of a key whose
+	value is #INI_GLOBAL_IMPLICIT_VALUE has #INI_TAPE_IMPLICIT_VALUE as
+	`v_offs`, and a record without value has #INI_TAPE_NO_VALUE.
+
+	The tape can be visited as many times as needed, and its keys can be looked up
+	using #ini_tape_find(). It must be freed using #ini_tape_free(). Buffers of
+	4 GiB or more cannot be stored in a tape.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_ENOMEM, #CONFINI_EOOR,
+	#CONFINI_EFBIG.
+
+**/
+int ini_tape_build (
+	char * const ini_source,
+	const size_t ini_length,
+	const IniFormat format,
+	const IniTape ** const dest
+) {
+
+	if (ini_length >= INI_TAPE_IMPLICIT_VALUE) {
+
+		return CONFINI_EFBIG;
+
+	}
+
+	struct tape_builder builder;
+	IniReader reader = ini_reader_init(ini_source, ini_length, format);
+	uint_least32_t * tmp = (uint_least32_t *) 0;
+	IniTape * tape;
+	size_t n_keys = 0, idx;
+	int return_value;
+
+	if ((return_value = start_tape_builder(&builder))) {
+
+		goto free_and_exit;
+
+	}
+
+	while (
+		!(return_value = move_tape_parent(&builder, &reader)) &&
+		!(return_value = pull_ini_node(&reader)) &&
+		!(return_value = add_tape_record(&builder, &reader.dispatch, ini_source))
+	);
+
+	if (return_value != CONFINI_EOF) {
+
+		goto free_and_exit;
+
+	}
+
+	const IniTapeRecord * const records = (const IniTapeRecord *) builder.records;
+
+	for (idx = 0; idx < builder.n_records; idx++) {
+
+		n_keys += records[idx].type == INI_KEY;
+
+	}
+
+	tape = (IniTape *) malloc(sizeof(IniTape) + n_keys * sizeof(uint_least32_t));
+
+	if (!tape || !(tmp = (uint_least32_t *) malloc(n_keys * sizeof(uint_least32_t) + 1))) {
+
+		free(tape);
+		return_value = CONFINI_ENOMEM;
+		goto free_and_exit;
+
+	}
+
+	uint_least32_t * const keys = (uint_least32_t *) (tape + 1);
+
+	tape->ini_source = ini_source;
+	tape->paths = builder.paths;
+	tape->records = records;
+	tape->sections = (const IniTapeSection *) builder.sections;
+	tape->keys = keys;
+	tape->n_records = builder.n_records;
+	tape->n_sections = builder.n_sections;
+	tape->n_keys = n_keys;
+	tape->format = format;
+
+	for (n_keys = 0, idx = 0; idx < builder.n_records; idx++) {
+
+		if (records[idx].type == INI_KEY) {
+
+			keys[n_keys++] = (uint_least32_t) idx;
+
+		}
+
+	}
+
+	sort_tape_keys(tape, keys, tmp, n_keys);
+
+	/*  The strings now belong to the tape  */
+	builder.records = (char *) 0;
+	builder.sections = (char *) 0;
+	builder.paths = (char *) 0;
+	*dest = tape;
+	return_value = CONFINI_SUCCESS;
+
+
+	/* \                                /\
+	\ */     free_and_exit:            /* \
+	 \/     ______________________     \ */
+
+
+	free(tmp);
+	free(builder.parents[0]);
+	free(builder.parents[1]);
+	free(builder.paths);
+	free(builder.sections);
+	free(builder.records);
+	return return_value;
+
+}
+
+
+                                                     /** @utility{ini_tape_find} **/
+/**
+
+	@brief          Look up a key in a tape
+	@param          tape            The tape
+	@param          section_path    The normalized section path (as dispatched
+	                                in `IniDispatch::append_to`), or `NULL` for
+	                                the root section
+	@param          key_name        The normalized key name (as dispatched in
+	                                `IniDispatch::data`)
+	@return         The record of the key, or `NULL` if the key was not found
+
+	The lookup is a binary search on the `keys` member of the tape, which lists
+	the records of all the keys sorted by section path and key name. The strings
+	are compared byte by byte, except that the case of the ASCII letters is
+	ignored if the format of the tape is case-insensitive. When the same key
+	appears more than once in the same section, the last one is returned.
+
+**/
+const IniTapeRecord * ini_tape_find (
+	const IniTape * const tape,
+	const char * const section_path,
+	const char * const key_name
+) {
+
+	const char * const section = section_path ? section_path : "";
+	size_t section_len = 0, key_len = 0, first = 0, last = tape->n_keys, mid;
+
+	while (section[section_len]) {
+
+		section_len++;
+
+	}
+
+	while (key_name[key_len]) {
+
+		key_len++;
+
+	}
+
+	/*  Find the first key that follows the one searched  */
+
+	while (first < last) {
+
+		mid = first + ((last - first) >> 1);
+
+		if (
+			compare_tape_key(
+				tape,
+				section,
+				section_len,
+				key_name,
+				key_len,
+				tape->records + tape->keys[mid]
+			) < 0
+		) {
+
+			last = mid;
+
+		} else {
+
+			first = mid + 1;
+
+		}
+
+	}
+
+	return
+		first && !compare_tape_key(
+			tape,
+			section,
+			section_len,
+			key_name,
+			key_len,
+			tape->records + tape->keys[first - 1]
+		) ?
+			tape->records + tape->keys[first - 1]
+		:
+			(const IniTapeRecord *) 0;
+
+}
+
+
+                                                     /** @utility{ini_tape_free} **/
+/**
+
+	@brief          Free a tape created by #ini_tape_build()
+	@param          tape            The tape to free, or `NULL`
+	@return         Nothing
+
+	The buffer the tape refers to is not freed.
+
+**/
+void ini_tape_free (
+	const IniTape * const tape
+) {
+
+	if (tape) {
+
+		free((void *) tape->paths);
+		free((void *) tape->sections);
+		free((void *) tape->records);
+		free((void *) tape);
+
+	}
+
+}
+
+
+                                                 /** @utility{ini_document_open} **/
+/**
+
+	@brief          Parse an INI buffer into a document that can be parsed again
+	                incrementally after each edit
+	@param          ini_source      The buffer containing the INI file, which
+	                                is copied and never modified
+	@param          ini_length      The length of @p ini_source without its
+	                                terminating `NUL` character (if any)
+	@param          format          The format of the INI file
+	@param          f_delta         The function that will be invoked for each
+	                                node, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@param          dest            The address where the new document will be
+	                                stored
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	Each node is passed to @p f_delta as #INI_DELTA_ADDED, exactly as
+	#strip_ini_cache() would dispatch it. If @p f_delta returns a non-zero value
+	the dispatching stops and #CONFINI_FEINTR is returned, but the document is
+	stored in @p dest all the same; after any other error nothing is stored.
+
+	The document must be freed with #ini_document_close(). Documents of 4 GiB or
+	more are not supported (#CONFINI_EFBIG is returned).
+
+**/
+int ini_document_open (
+	const char * const ini_source,
+	const size_t ini_length,
+	const IniFormat format,
+	const IniDeltaHandler f_delta,
+	void * const user_data,
+	IniDocument ** const dest
+) {
+
+	if (ini_length >= INI_TAPE_IMPLICIT_VALUE) {
+
+		return CONFINI_EFBIG;
+
+	}
+
+	IniDocument * const doc = (IniDocument *) malloc(sizeof(IniDocument));
+
+	if (!doc) {
+
+		return CONFINI_ENOMEM;
+
+	}
+
+	struct doc_context context = { { 0, 0 }, { 0, 0 }, _CONFINI_FALSE_ };
+	struct doc_parse parse;
+	size_t idx;
+	int return_value;
+
+	doc->text = (char *) 0;
+	doc->segments = (char *) 0;
+	doc->paths = (char *) 0;
+	doc->text_len = ini_length;
+	doc->text_size = 0;
+	doc->n_segments = 0;
+	doc->segments_size = 0;
+	doc->paths_len = 1;
+	doc->paths_size = 0;
+	doc->format = format;
+
+	if (
+		(return_value = start_doc_parse(&parse)) ||
+		(return_value = grow_buffer(&doc->text, &doc->text_size, ini_length + 1)) ||
+		(return_value = grow_buffer(&doc->paths, &doc->paths_size, 1))
+	) {
+
+		goto free_and_exit;
+
+	}
+
+	for (idx = 0; idx < ini_length; idx++) {
+
+		doc->text[idx] = ini_source[idx];
+
+	}
+
+	*doc->paths = '\0';
+
+	if (
+		(return_value = parse_doc_region(
+			doc,
+			&parse,
+			doc->text,
+			ini_length,
+			0,
+			_CONFINI_TRUE_,
+			&context
+		))
+	) {
+
+		goto free_and_exit;
+
+	}
+
+	doc->segments = parse.segments;
+	doc->segments_size = parse.segments_size;
+	doc->n_segments = parse.n_segments;
+	parse.segments = (char *) 0;
+	*dest = doc;
+
+	for (idx = 0; f_delta && idx < parse.builder.n_records; idx++) {
+
+		if (
+			dispatch_doc_node(
+				doc,
+				&parse,
+				idx,
+				idx,
+				INI_DELTA_ADDED,
+				f_delta,
+				user_data
+			)
+		) {
+
+			free_doc_parse(&parse);
+			return CONFINI_FEINTR;
+
+		}
+
+	}
+
+	free_doc_parse(&parse);
+	return CONFINI_SUCCESS;
+
+
+	/* \                                /\
+	\ */     free_and_exit:            /* \
+	 \/     ______________________     \ */
+
+
+	free_doc_parse(&parse);
+	ini_document_close(doc);
+	return return_value;
+
+}
+
+
+                                                 /** @utility{ini_document_edit} **/
+/**
+
+	@brief          Replace a range of the text of a document and parse again
+	                only the nodes that the edit can have changed
+	@param          document        The document to edit
+	@param          edit_at         The offset of the range to replace
+	@param          old_len         The length of the range to replace
+	@param          new_text        The text that replaces the range (it must
+	                                not belong to the document)
+	@param          new_len         The length of @p new_text
+	@param          f_delta         The function that will be invoked for each
+	                                node added, removed or changed, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	Only the lines touched by the edit are parsed again, followed by the lines
+	whose parent section has changed as a consequence of the edit (for instance
+	when a section path has been renamed); each of them is parsed exactly as
+	#strip_ini_cache() would parse it. The nodes found are compared with the
+	nodes that the same lines contained before the edit, and the differences are
+	passed to @p f_delta: the `dispatch_id` of each dispatch is its position in
+	the whole document after the edit, and its `change` argument is one of the
+	values of `enum` #IniDeltaType. Nodes that are identical before and after the
+	edit are not passed. If the edit changes the number of nodes, the nodes
+	reported as #INI_DELTA_CHANGED come first, then those reported as
+	#INI_DELTA_REMOVED (which all have the `dispatch_id` of the position they
+	leave free), then those reported as #INI_DELTA_ADDED.
+
+	The dispatches remain valid only until @p f_delta returns. If @p f_delta
+	returns a non-zero value the dispatching stops and #CONFINI_FEINTR is
+	returned, but the edit is kept. After any other error the document is left
+	as it was before the edit. If the range does not lie within the document
+	#CONFINI_EOOR is returned.
+
+	Moving the text that follows the edit and updating the line offsets takes a
+	time proportional to the size of the document, but the parsing takes a time
+	proportional to the size of the lines affected.
+
+**/
+int ini_document_edit (
+	IniDocument * const document,
+	const size_t edit_at,
+	const size_t old_len,
+	const char * const new_text,
+	const size_t new_len,
+	const IniDeltaHandler f_delta,
+	void * const user_data
+) {
+
+	if (edit_at > document->text_len || old_len > document->text_len - edit_at) {
+
+		return CONFINI_EOOR;
+
+	}
+
+	if (
+		new_len >= INI_TAPE_IMPLICIT_VALUE - document->text_len + old_len
+	) {
+
+		return CONFINI_EFBIG;
+
+	}
+
+	struct doc_segment * segments = (struct doc_segment *) document->segments;
+	const size_t n_segments = document->n_segments;
+	struct doc_context old_context, new_context;
+	struct doc_parse old_parse, new_parse;
+	size_t first = 0, edit_last = n_segments, last, idx, region_at, region_end,
+		first_id = 0;
+	int return_value;
+
+	if ((return_value = start_doc_parse(&old_parse))) {
+
+		free_doc_parse(&old_parse);
+		return return_value;
+
+	}
+
+	if ((return_value = start_doc_parse(&new_parse))) {
+
+		goto free_and_exit;
+
+	}
+
+	/*  The segment that contains the edit (a BOM belongs to the first one)  */
+
+	if (edit_at > 2) {
+
+		idx = n_segments;
+
+		while (idx - first > 1) {
+
+			if (segments[(first + idx) >> 1].at > edit_at) {
+
+				idx = (first + idx) >> 1;
+
+			} else {
+
+				first = (first + idx) >> 1;
+
+			}
+
+		}
+
+	}
+
+	/*  The first segment that the edit does not touch  */
+
+	for (idx = first + 1; idx < n_segments; idx++) {
+
+		if (segments[idx].at >= edit_at + old_len) {
+
+			edit_last = idx;
+			break;
+
+		}
+
+	}
+
+	/*  Parse the affected segments before the edit  */
+
+	old_context = segments[first].context;
+
+	if (
+		(return_value = parse_doc_region(
+			document,
+			&old_parse,
+			document->text + segments[first].at,
+			(
+				edit_last < n_segments ?
+					segments[edit_last].at
+				:
+					document->text_len
+			) - segments[first].at,
+			segments[first].at,
+			edit_last == n_segments,
+			&old_context
+		)) || (return_value = splice_doc_text(
+			document,
+			edit_at,
+			old_len,
+			new_text,
+			new_len
+		))
+	) {
+
+		goto free_and_exit;
+
+	}
+
+	/*
+
+		Parse the affected segments after the edit, until the segmentation has
+		realigned with the old one and the section context has not changed
+
+	*/
+
+	new_context = segments[first].context;
+	region_at = segments[first].at;
+	region_end = region_at;
+	last = edit_last;
+
+	for (;;) {
+
+		do {
+
+			region_end = find_doc_segment_end(
+				document->text,
+				region_end,
+				document->text_len,
+				document->format
+			);
+
+			while (
+				last < n_segments &&
+				segments[last].at + new_len < region_end + old_len
+			) {
+
+				last++;
+
+			}
+
+		} while (
+			region_end <= document->text_len && (
+				region_end < edit_at + new_len ||
+				last == n_segments ||
+				segments[last].at + new_len != region_end + old_len
+			)
+		);
+
+		if (region_end > document->text_len) {
+
+			last = n_segments;
+
+		}
+
+		if (
+			(return_value = parse_doc_region(
+				document,
+				&new_parse,
+				document->text + region_at,
+				(
+					last < n_segments ? region_end : document->text_len
+				) - region_at,
+				region_at,
+				last == n_segments,
+				&new_context
+			))
+		) {
+
+			goto revert_and_exit;
+
+		}
+
+		if (
+			last == n_segments ||
+			doc_contexts_equal(document, &new_context, &segments[last].context)
+		) {
+
+			break;
+
+		}
+
+		/*  The section context has changed: the next segment is affected too  */
+		region_at = region_end;
+
+	}
+
+	/*  Parse the segments that followed the edit and have been affected  */
+
+	if (edit_last < last) {
+
+		old_context = segments[edit_last].context;
+
+		if (
+			(return_value = parse_doc_region(
+				document,
+				&old_parse,
+				document->text + segments[edit_last].at - old_len + new_len,
+				(
+					last < n_segments ?
+						segments[last].at
+					:
+						document->text_len - new_len + old_len
+				) - segments[edit_last].at,
+				segments[edit_last].at - old_len + new_len,
+				last == n_segments,
+				&old_context
+			))
+		) {
+
+			goto revert_and_exit;
+
+		}
+
+	}
+
+	/*  Replace the old segments with the new ones  */
+
+	const size_t new_n_segments = n_segments - last + first + new_parse.n_segments;
+
+	if (
+		(return_value = grow_buffer(
+			&document->segments,
+			&document->segments_size,
+			new_n_segments * sizeof(struct doc_segment)
+		))
+	) {
+
+		goto revert_and_exit;
+
+	}
+
+	segments = (struct doc_segment *) document->segments;
+
+	for (idx = 0; idx < first; idx++) {
+
+		first_id += segments[idx].n_nodes;
+
+	}
+
+	if (new_n_segments > n_segments) {
+
+		for (idx = n_segments; idx > last; idx--) {
+
+			segments[idx - last + first + new_parse.n_segments - 1] =
+				segments[idx - 1];
+
+		}
+
+	} else if (new_n_segments < n_segments) {
+
+		for (idx = last; idx < n_segments; idx++) {
+
+			segments[idx - last + first + new_parse.n_segments] = segments[idx];
+
+		}
+
+	}
+
+	for (idx = first + new_parse.n_segments; idx < new_n_segments; idx++) {
+
+		segments[idx].at = segments[idx].at - old_len + new_len;
+
+	}
+
+	for (idx = 0; idx < new_parse.n_segments; idx++) {
+
+		segments[first + idx] =
+			((const struct doc_segment *) new_parse.segments)[idx];
+
+	}
+
+	document->n_segments = new_n_segments;
+
+	return_value = f_delta ?
+		dispatch_doc_delta(
+			document,
+			&old_parse,
+			&new_parse,
+			first_id,
+			f_delta,
+			user_data
+		)
+	:
+		CONFINI_SUCCESS;
+
+	goto free_and_exit;
+
+
+	/* \                                /\
+	\ */     revert_and_exit:          /* \
+	 \/     ______________________     \ */
+
+
+	/*  The old text of the range is still in the first region of `old_parse`  */
+	splice_doc_text(
+		document,
+		edit_at,
+		new_len,
+		old_parse.region + edit_at - segments[first].at,
+		old_len
+	);
+
+
+	/* \                                /\
+	\ */     free_and_exit:            /* \
+	 \/     ______________________     \ */
+
+
+	free_doc_parse(&new_parse);
+	free_doc_parse(&old_parse);
+	return return_value;
+
+}
+
+
+                                                /** @utility{ini_document_close} **/
+/**
+
+	@brief          Free a document created by #ini_document_open()
+	@param          document        The document to free, or `NULL`
+	@return         Nothing
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+**/
+void ini_document_close (
+	IniDocument * const document
+) {
+
+	if (document) {
+
+		free(document->text);
+		free(document->segments);
+		free(document->paths);
+		free(document);
+
+	}
+
+}
+
+
+
+
+                                                     /** @utility{load_ini_file} **/
+/**
+
+	@brief          Parse an INI file and dispatch its content to a custom callback
+	                using a `FILE` structure as argument
+	@param          ini_file        The `FILE` handle pointing to the INI file to
+	                                parse
+	@param          format          The format of the INI file
+	@param          f_init          The function that will be invoked before the
+	                                first dispatch, or `NULL`
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	The @p ini_file parameter must be a `FILE` handle with read privileges. On some
+	platforms, such as Microsoft Windows, it might be necessary to add the binary
+	specifier to the mode string (`"b"`) in order to prevent discrepancies between
+	the physical size of the file and its computed size. Adding the binary specifier
+	guarantees portability across all platforms:
+
+	~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+	FILE * my_file = fopen("example.conf", "rb");
+	~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+	If @p ini_file is a seekable stream the whole file is parsed, independently of
+	the current position of the stream. Non-seekable streams (pipes, sockets,
+	terminals, `stdin`, etc.) are instead read from their current position until
+	end-of-file, using a buffer that doubles its size whenever it gets full, and
+	parsed at once when the end of the stream has been reached.
+
+	For the two parameters @p f_init and @p f_foreach see function
+	#strip_ini_cache().
+
+	The parsing algorithms used by **libconfini** are able to parse any type of file
+	encoded in 8-bit code units, as long as the characters that match the regular
+	expression `/[\s\[\]\.\\;#"']/` refer to the same code points they refer to in
+	ASCII (as they do, for example, in UTF-8 and ISO-8859-1), independently of
+	platform-specific conventions.
+
+	@note   In order to be null-byte-injection safe, `NUL` characters, if present in
+	        the file, will be removed from the dispatched strings.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_IINTR, #CONFINI_FEINTR,
+	#CONFINI_ENOMEM, #CONFINI_EIO, #CONFINI_EOOR, #CONFINI_EFBIG.
+
+	@include topics/load_ini_file.c
+
+**/
+int load_ini_file (
+	FILE * const ini_file,
+	const IniFormat format,
+	const IniStatsHandler f_init,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	IniLoadBuffer buffer = { (char *) 0, 0 };
+
+	const int return_value = load_ini_file_buf(
+		ini_file,
+		&buffer,
+		format,
+		f_init,
+		f_foreach,
+		user_data
+	);
+
+	free(buffer.cache);
+	return return_value;
+
+}
+
+
+                                                     /** @utility{load_ini_path} **/
+/**
+
+	@brief          Parse an INI file and dispatch its content to a custom callback
+	                using a path as argument
+	@param          path            The path of the INI file
+	@param          format          The format of the INI file
+	@param          f_init          The function that will be invoked before the
+	                                first dispatch, or `NULL`
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	For the two parameters @p f_init and @p f_foreach see function
+	#strip_ini_cache().
+
+	The parsing algorithms used by **libconfini** are able to parse any type of file
+	encoded in 8-bit code units, as long as the characters that match the regular
+	expression `/[\s\[\]\.\\;#"']/` refer to the same code points they refer to in
+	ASCII (as they do, for example, in UTF-8 and ISO-8859-1), independently of
+	platform-specific conventions.
+
+	@note   In order to be null-byte-injection safe, `NUL` characters, if present in
+	        the file, will be removed from the dispatched strings.
+
+	Paths of non-seekable files (such as named pipes) are supported; see
+	#load_ini_file() for more details.
+
+	If the parse cache has been enabled (see #ini_cache_set_budget()), a file that
+	has already been parsed with the same format and has not changed since then is
+	not read again: its dispatches are replayed from memory instead.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_IINTR, #CONFINI_FEINTR,
+	#CONFINI_ENOENT, #CONFINI_ENOMEM, #CONFINI_EIO, #CONFINI_EOOR, #CONFINI_EFBIG.
+
+	@include topics/load_ini_path.c
+
+**/
+int load_ini_path (
+	const char * const path,
+	const IniFormat format,
+	const IniStatsHandler f_init,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
+
+	/*  A disabled cache costs a relaxed load, and no lock  */
+	if (_CONFINI_ATOMIC_GET_(parse_cache.budget)) {
+
+		return load_cached_ini_path(path, format, f_init, f_foreach, user_data);
+
+	}
+
+	#endif
+
+	IniLoadBuffer buffer = { (char *) 0, 0 };
+
+	const int return_value = load_ini_path_buf(
+		path,
+		&buffer,
+		format,
+		f_init,
+		f_foreach,
+		user_data
+	);
+
+	free(buffer.cache);
+	return return_value;
+
+}
+
+
+                                                       /** @utility{load_ini_fd} **/
+/**
+
+	@brief          Parse an INI file and dispatch its content to a custom callback
+	                using a file descriptor as argument
+	@param          ini_fd          The file descriptor of the INI file to parse
+	@param          format          The format of the INI file
+	@param          f_init          The function that will be invoked before the
+	                                first dispatch, or `NULL`
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	The file descriptor @p ini_fd must have read privileges. If it refers to a
+	regular file, the buffer is sized with a single `fstat()` and the whole file is
+	read with `pread()`, independently of the current offset of @p ini_fd, which
+	is left untouched. Any other kind of file descriptor is accepted as well,
+	including pipes and sockets, and is read from its current position until
+	end-of-file: the content is accumulated in a buffer that doubles its size
+	whenever it gets full, then parsed at once. The file descriptor is never
+	closed by this function.
+
+	When **libconfini** has been compiled with the C Standard I/O API (see
+	`CONFINI_IO_FLAVOR`) file descriptors are not supported and this function
+	always returns #CONFINI_EBADF.
+
+	For the two parameters @p f_init and @p f_foreach see function
+	#strip_ini_cache().
+
+	@note   In order to be null-byte-injection safe, `NUL` characters, if present in
+	        the file, will be removed from the dispatched strings.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_IINTR, #CONFINI_FEINTR,
+	#CONFINI_ENOMEM, #CONFINI_EIO, #CONFINI_EOOR, #CONFINI_EBADF, #CONFINI_EFBIG.
+
+**/
+int load_ini_fd (
+	const int ini_fd,
+	const IniFormat format,
+	const IniStatsHandler f_init,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	IniLoadBuffer buffer = { (char *) 0, 0 };
+
+	const int return_value = load_ini_fd_buf(
+		ini_fd,
+		&buffer,
+		format,
+		f_init,
+		f_foreach,
+		user_data
+	);
+
+	free(buffer.cache);
+	return return_value;
+
+}
+
+
+                                                      /** @utility{load_ini_at} **/
+/**
+
+	@brief          Parse an INI file and dispatch its content to a custom callback
+	                using a path relative to a directory file descriptor as
+	                argument
+	@param          dir_fd          The file descriptor of the directory that
+	                                @p path is relative to, or `AT_FDCWD`
+	@param          path            The path of the INI file
+	@param          format          The format of the INI file
+	@param          f_init          The function that will be invoked before the
+	                                first dispatch, or `NULL`
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	The file is opened using `openat()`, so that processes that have been
+	sandboxed to a set of directory descriptors (e.g. via Capsicum, or after a
+	`chroot()`) can still parse the files they are allowed to see. If @p path is
+	absolute @p dir_fd is ignored; if @p dir_fd is `AT_FDCWD` this function is
+	equivalent to #load_ini_path(). The file is then read as #load_ini_fd() does.
+
+	When **libconfini** has been compiled with the C Standard I/O API (see
+	`CONFINI_IO_FLAVOR`) file descriptors are not supported and this function
+	always returns #CONFINI_EBADF.
+
+	For the two parameters @p f_init and @p f_foreach see function
+	#strip_ini_cache().
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_IINTR, #CONFINI_FEINTR,
+	#CONFINI_ENOENT, #CONFINI_ENOMEM, #CONFINI_EIO, #CONFINI_EOOR, #CONFINI_EBADF,
+	#CONFINI_EFBIG.
+
+**/
+int load_ini_at (
+	const int dir_fd,
+	const char * const path,
+	const IniFormat format,
+	const IniStatsHandler f_init,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	IniLoadBuffer buffer = { (char *) 0, 0 };
+
+	const int return_value = load_ini_at_buf(
+		dir_fd,
+		path,
+		&buffer,
+		format,
+		f_init,
+		f_foreach,
+		user_data
+	);
+
+	free(buffer.cache);
+	return return_value;
+
+}
+
+
+                                                /** @utility{load_ini_path_mmap} **/
+/**
+
+	@brief          Parse an INI file and dispatch its content to a custom callback
+	                using a path as argument, without copying the file into the
+	                heap
+	@param          path            The path of the INI file
+	@param          format          The format of the INI file
+	@param          f_init          The function that will be invoked before the
+	                                first dispatch, or `NULL`
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	This function dispatches what #load_ini_path() would dispatch, but instead of
+	allocating a buffer and reading the file into it, the file is mapped read-only
+	into memory and parsed by #strip_ini_const_cache(), which never writes to it.
+	The pages of the file are therefore shared with the page cache and are never
+	copied as a whole: only one segment at a time (a line, or a group of lines
+	joined by escaped line breaks) is copied into a side buffer and normalized
+	there, so the memory used depends only on the size of the longest segment.
+	When @p f_init is not `NULL` the mapping is scanned twice (see
+	#strip_ini_const_cache()).
+
+	If @p path does not refer to a regular file, or if the file cannot be mapped,
+	the function silently falls back to #load_ini_path().
+
+	When **libconfini** has been compiled with the C Standard I/O API (see
+	`CONFINI_IO_FLAVOR`) this function is merely an alias of #load_ini_path().
+
+	@warning    The file remains mapped until this function returns. If in the
+	            meanwhile the file is truncated, reading the pages that lie beyond
+	            its new end makes the process receive a `SIGBUS` signal, which by
+	            default terminates it. Do not use this function on files that other
+	            processes might truncate while they are being parsed (replacing a
+	            file through `rename()` is safe).
+
+	For the two parameters @p f_init and @p f_foreach see function
+	#strip_ini_cache().
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_IINTR, #CONFINI_FEINTR,
+	#CONFINI_ENOENT, #CONFINI_ENOMEM, #CONFINI_EIO, #CONFINI_EOOR, #CONFINI_EFBIG.
+
+**/
+int load_ini_path_mmap (
+	const char * const path,
+	const IniFormat format,
+	const IniStatsHandler f_init,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
+
+	const int ini_fd = open(path, O_RDONLY);
+
+	if (ini_fd < 0) {
+
+		return CONFINI_ENOENT;
+
+	}
+
+	struct stat file_stat;
+
+	if (fstat(ini_fd, &file_stat) || !S_ISREG(file_stat.st_mode)) {
+
+		/*  No checks here, as there is nothing we can do about it...  */
+		close(ini_fd);
+		return load_ini_path(path, format, f_init, f_foreach, user_data);
+
+	}
+
+	if ((uintmax_t) file_stat.st_size >= SIZE_MAX) {
+
+		/*  No checks here, as there is nothing we can do about it...  */
+		close(ini_fd);
+		return CONFINI_EFBIG;
+
+	}
+
+	const size_t file_size = (size_t) file_stat.st_size;
+
+	if (!file_size) {
+
+		/*  No checks here, as there is nothing we can do about it...  */
+		close(ini_fd);
+
+		char empty_cache[1];
+
+		return strip_ini_cache(
+			empty_cache,
+			0,
+			format,
+			f_init,
+			f_foreach,
+			user_data
+		);
+
+	}
+
+	char * const cache = (char *) mmap(
+		(void *) 0,
+		file_size,
+		PROT_READ,
+		MAP_PRIVATE,
+		ini_fd,
+		0
+	);
+
+	/*  No checks here, as there is nothing we can do about it...  */
+	close(ini_fd);
+
+	if (cache == (char *) MAP_FAILED) {
+
+		return load_ini_path(path, format, f_init, f_foreach, user_data);
+
+	}
+
+	#ifdef _CONFINI_DECOMPRESS_
+
+	if (get_compression_format((unsigned char *) cache, file_size)) {
+
+		/*  Compressed files cannot be parsed from the mapping  */
+		munmap(cache, file_size);
+		return load_ini_path(path, format, f_init, f_foreach, user_data);
+
+	}
+
+	#endif
+
+	const int return_value = strip_ini_const_cache(
+		cache,
+		file_size,
+		format,
+		f_init,
+		f_foreach,
+		user_data
+	);
+
+	/*  No checks here, as there is nothing we can do about it...  */
+	munmap(cache, file_size);
+
+	return return_value;
+
+	#else
+
+	return load_ini_path(path, format, f_init, f_foreach, user_data);
+
+	#endif
+
+}
+
+
+                                                 /** @utility{load_ini_file_buf} **/
+/**
+
+	@brief          Parse an INI file and dispatch its content to a custom callback
+	                using a `FILE` structure as argument and a reusable buffer
+	@param          ini_file        The `FILE` handle pointing to the INI file to
+	                                parse
+	@param          buffer          The buffer where to load the file
+	@param          format          The format of the INI file
+	@param          f_init          The function that will be invoked before the
+	                                first dispatch, or `NULL`
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	This function behaves exactly like #load_ini_file(), but instead of allocating
+	and freeing a new buffer at each call, it loads the file into @p buffer, which
+	is owned by the caller and grown only when the file does not fit in it. The
+	same buffer can be passed to any number of subsequent calls, thus sparing one
+	allocation per file when many files are parsed in a row.
+
+	Before its first use @p buffer must be zero-initialized:
+
+	~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+	IniLoadBuffer my_buffer = { NULL, 0 };
+	~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+	After the last use it must be freed using #ini_load_buffer_free(), or its
+	memory can be taken over using #ini_load_buffer_detach(). The buffer must be
+	freed also when the function fails.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_IINTR, #CONFINI_FEINTR,
+	#CONFINI_ENOMEM, #CONFINI_EIO, #CONFINI_EOOR, #CONFINI_EFBIG.
+
+**/
+int load_ini_file_buf (
+	FILE * const ini_file,
+	IniLoadBuffer * const buffer,
+	const IniFormat format,
+	const IniStatsHandler f_init,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	size_t cache_len;
+
+	const int read_err = read_ini_file(ini_file, buffer, &cache_len);
+
+	return read_err ? read_err : strip_ini_cache(
+		buffer->cache,
+		cache_len,
+		format,
+		f_init,
+		f_foreach,
+		user_data
+	);
+
+}
+
+
+                                                 /** @utility{load_ini_path_buf} **/
+/**
+
+	@brief          Parse an INI file and dispatch its content to a custom callback
+	                using a path as argument and a reusable buffer
+	@param          path            The path of the INI file
+	@param          buffer          The buffer where to load the file
+	@param          format          The format of the INI file
+	@param          f_init          The function that will be invoked before the
+	                                first dispatch, or `NULL`
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	This function behaves exactly like #load_ini_path(), but loads the file into a
+	caller-owned buffer that can be reused across calls. See #load_ini_file_buf()
+	for more details.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_IINTR, #CONFINI_FEINTR,
+	#CONFINI_ENOENT, #CONFINI_ENOMEM, #CONFINI_EIO, #CONFINI_EOOR, #CONFINI_EFBIG.
+
+	@include topics/load_ini_path_buf.c
+
+**/
+int load_ini_path_buf (
+	const char * const path,
+	IniLoadBuffer * const buffer,
+	const IniFormat format,
+	const IniStatsHandler f_init,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
+
+	/*  Bypass the C Standard I/O buffers: one `fstat()` and one `pread()`  */
+	return load_ini_at_buf(
+		AT_FDCWD,
+		path,
+		buffer,
+		format,
+		f_init,
+		f_foreach,
+		user_data
+	);
+
+	#else
+
+	FILE * const ini_file = fopen(path, "rb");
+
+	if (!ini_file) {
+
+		return CONFINI_ENOENT;
+
+	}
+
+	size_t cache_len;
+
+	const int read_err = read_ini_file(ini_file, buffer, &cache_len);
+
+	/*  No checks here, as there is nothing we can do about it...  */
+	fclose(ini_file);
+
+	return read_err ? read_err : strip_ini_cache(
+		buffer->cache,
+		cache_len,
+		format,
+		f_init,
+		f_foreach,
+		user_data
+	);
+
+	#endif
+
+}
+
+
+                                                   /** @utility{load_ini_fd_buf} **/
+/**
+
+	@brief          Parse an INI file and dispatch its content to a custom callback
+	                using a file descriptor as argument and a reusable buffer
+	@param          ini_fd          The file descriptor of the INI file to parse
+	@param          buffer          The buffer where to load the file
+	@param          format          The format of the INI file
+	@param          f_init          The function that will be invoked before the
+	                                first dispatch, or `NULL`
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	This function behaves exactly like #load_ini_fd(), but loads the file into a
+	caller-owned buffer that can be reused across calls. See #load_ini_file_buf()
+	for more details.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_IINTR, #CONFINI_FEINTR,
+	#CONFINI_ENOMEM, #CONFINI_EIO, #CONFINI_EOOR, #CONFINI_EBADF, #CONFINI_EFBIG.
+
+**/
+int load_ini_fd_buf (
+	const int ini_fd,
+	IniLoadBuffer * const buffer,
+	const IniFormat format,
+	const IniStatsHandler f_init,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
+
+	if (ini_fd < 0) {
+
+		return CONFINI_EBADF;
+
+	}
+
+	size_t cache_len;
+
+	const int read_err = read_ini_fd(ini_fd, buffer, &cache_len);
+
+	return read_err ? read_err : strip_ini_cache(
+		buffer->cache,
+		cache_len,
+		format,
+		f_init,
+		f_foreach,
+		user_data
+	);
+
+	#else
+
+	(void) ini_fd;
+	(void) buffer;
+	(void) format;
+	(void) f_init;
+	(void) f_foreach;
+	(void) user_data;
+
+	return CONFINI_EBADF;
+
+	#endif
+
+}
+
+
+                                                  /** @utility{load_ini_at_buf} **/
+/**
+
+	@brief          Parse an INI file and dispatch its content to a custom callback
+	                using a path relative to a directory file descriptor as
+	                argument and a reusable buffer
+	@param          dir_fd          The file descriptor of the directory that
+	                                @p path is relative to, or `AT_FDCWD`
+	@param          path            The path of the INI file
+	@param          buffer          The buffer where to load the file
+	@param          format          The format of the INI file
+	@param          f_init          The function that will be invoked before the
+	                                first dispatch, or `NULL`
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	This function behaves exactly like #load_ini_at(), but loads the file into a
+	caller-owned buffer that can be reused across calls. See #load_ini_file_buf()
+	for more details.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_IINTR, #CONFINI_FEINTR,
+	#CONFINI_ENOENT, #CONFINI_ENOMEM, #CONFINI_EIO, #CONFINI_EOOR, #CONFINI_EBADF,
+	#CONFINI_EFBIG.
+
+**/
+int load_ini_at_buf (
+	const int dir_fd,
+	const char * const path,
+	IniLoadBuffer * const buffer,
+	const IniFormat format,
+	const IniStatsHandler f_init,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
+
+	const int ini_fd = openat(dir_fd, path, O_RDONLY);
+
+	if (ini_fd < 0) {
+
+		return errno == EBADF ? CONFINI_EBADF : CONFINI_ENOENT;
+
+	}
+
+	size_t cache_len;
+
+	const int read_err = read_ini_fd(ini_fd, buffer, &cache_len);
+
+	/*  No checks here, as there is nothing we can do about it...  */
+	close(ini_fd);
+
+	return read_err ? read_err : strip_ini_cache(
+		buffer->cache,
+		cache_len,
+		format,
+		f_init,
+		f_foreach,
+		user_data
+	);
+
+	#else
+
+	(void) dir_fd;
+	(void) path;
+	(void) buffer;
+	(void) format;
+	(void) f_init;
+	(void) f_foreach;
+	(void) user_data;
+
+	return CONFINI_EBADF;
+
+	#endif
+
+}
+
+
+                                                      /** @utility{load_ini_dir} **/
+/**
+
+	@brief          Parse all the INI files contained in a directory (`conf.d`
+	                style) and dispatch their content to custom callbacks
+	@param          dir_path        The path of the directory
+	@param          extension       The extension that the files must have in
+	                                order to be parsed (e.g. `".conf"`), or
+	                                `NULL` for parsing all files
+	@param          format          The format of the INI files
+	@param          f_file          The function that will be invoked before
+	                                parsing each file, or `NULL`
+	@param          f_init          The function that will be invoked before the
+	                                first dispatch of each file, or `NULL`
+	@param          f_foreach       The function that will be invoked for each
+	                                dispatch, or `NULL`
+	@param          user_data       A custom argument, or `NULL`
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	Only regular files whose name does not begin with a dot and ends with
+	@p extension are parsed. Files are sorted by name, byte by byte and
+	independently of the current locale, and are always dispatched in this order,
+	one after the other, as if #load_ini_path() had been invoked on each of them.
+
+	Since most of the time needed for loading many small files is spent waiting
+	for the disk, the files are read concurrently by a small pool of threads,
+	which never get more than a few files ahead of the file being dispatched. All
+	callbacks are invoked from the calling thread.
+
+	The user given function @p f_file (see #IniFileHandler data type) will be
+	invoked before parsing each file with three arguments: `file_name` (the name of
+	the file, relative to @p dir_path), `file_num` (the index of the file in the
+	sorted list, starting from zero) and `user_data` (the custom argument
+	@p user_data previously passed). If @p f_file returns a non-zero value the
+	function will be interrupted and #CONFINI_IINTR will be returned.
+
+	For the two parameters @p f_init and @p f_foreach see function
+	#strip_ini_cache(). The field #IniDispatch::dispatch_id restarts from zero with
+	each file.
+
+	When **libconfini** has been compiled with the C Standard I/O API (see
+	`CONFINI_IO_FLAVOR`) directories are not supported and this function always
+	returns #CONFINI_ENOENT.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_IINTR, #CONFINI_FEINTR,
+	#CONFINI_ENOENT, #CONFINI_ENOMEM, #CONFINI_EIO, #CONFINI_EOOR, #CONFINI_EFBIG.
+
+**/
+int load_ini_dir (
+	const char * const dir_path,
+	const char * const extension,
+	const IniFormat format,
+	const IniFileHandler f_file,
+	const IniStatsHandler f_init,
+	const IniDispHandler f_foreach,
+	void * const user_data
+) {
+
+	#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
+
+	DIR * const dir = opendir(dir_path);
+
+	if (!dir) {
+
+		return CONFINI_ENOENT;
+
+	}
+
+	struct dir_reader reader = {
+		.fragments = (struct dir_fragment *) 0,
+		.n_fragments = 0,
+		.next_read = 0,
+		.n_dispatched = 0,
+		.dir_fd = dirfd(dir),
+		.must_stop = _CONFINI_FALSE_
+	};
+
+	const size_t ext_len = extension ? strlen(extension) : 0;
+	size_t frags_size = 0, name_len, idx;
+	struct dir_fragment * new_fragments;
+	const struct dirent * entry;
+	struct stat file_stat;
+	pthread_t workers[_CONFINI_DIR_WORKERS_];
+	size_t n_workers = 0;
+	int return_value = CONFINI_SUCCESS;
+
+
+	/*  Enumerate the fragments  */
+
+	while ((entry = readdir(dir))) {
+
+		if (
+			*entry->d_name == '.' ||
+			(name_len = strlen(entry->d_name)) < ext_len || (
+				ext_len &&
+				strcmp(entry->d_name + name_len - ext_len, extension)
+			) ||
+			fstatat(reader.dir_fd, entry->d_name, &file_stat, 0) ||
+			!S_ISREG(file_stat.st_mode)
+		) {
+
+			continue;
+
+		}
+
+		if (reader.n_fragments == frags_size) {
+
+			new_fragments = (struct dir_fragment *) realloc(
+				reader.fragments,
+				(frags_size = frags_size ? frags_size << 1 : 16) *
+					sizeof(struct dir_fragment)
+			);
+
+			if (!new_fragments) {
+
+				return_value = CONFINI_ENOMEM;
+				goto free_and_exit;
+
+			}
+
+			reader.fragments = new_fragments;
+
+		}
+
+		reader.fragments[reader.n_fragments] = (struct dir_fragment) {
+			.name = strdup(entry->d_name),
+			.buffer = { (char *) 0, 0 },
+			.len = 0,
+			.status = CONFINI_SUCCESS,
+			.is_ready = _CONFINI_FALSE_
+		};
+
+		if (!reader.fragments[reader.n_fragments++].name) {
+
+			return_value = CONFINI_ENOMEM;
+			goto free_and_exit;
+
+		}
+
+	}
+
+	if (!reader.n_fragments) {
+
+		goto free_and_exit;
+
+	}
+
+	qsort(
+		reader.fragments,
+		reader.n_fragments,
+		sizeof(struct dir_fragment),
+		compare_dir_fragments
+	);
+
+
+	/*  Start the readers (if no thread can be created, read sequentially)  */
+
+	pthread_mutex_init(&reader.lock, (pthread_mutexattr_t *) 0);
+	pthread_cond_init(&reader.change, (pthread_condattr_t *) 0);
+
+	while (
+		n_workers < _CONFINI_DIR_WORKERS_ &&
+		n_workers + 1 < reader.n_fragments &&
+		!pthread_create(
+			workers + n_workers,
+			(pthread_attr_t *) 0,
+			read_dir_fragments,
+			&reader
+		)
+	) {
+
+		n_workers++;
+
+	}
+
+
+	/*  Dispatch the fragments in order  */
+
+	for (idx = 0; idx < reader.n_fragments; idx++) {
+
+		if (n_workers) {
+
+			pthread_mutex_lock(&reader.lock);
+
+			while (!reader.fragments[idx].is_ready) {
+
+				pthread_cond_wait(&reader.change, &reader.lock);
+
+			}
+
+			pthread_mutex_unlock(&reader.lock);
+
+		} else {
+
+			read_dir_fragment(reader.dir_fd, reader.fragments + idx);
+
+		}
+
+		if (reader.fragments[idx].status) {
+
+			return_value = reader.fragments[idx].status;
+			break;
+
+		}
+
+		if (f_file && f_file(reader.fragments[idx].name, idx, user_data)) {
+
+			return_value = CONFINI_IINTR;
+			break;
+
+		}
+
+		if (
+			(return_value = strip_ini_cache(
+				reader.fragments[idx].buffer.cache,
+				reader.fragments[idx].len,
+				format,
+				f_init,
+				f_foreach,
+				user_data
+			))
+		) {
+
+			break;
+
+		}
+
+		ini_load_buffer_free(&reader.fragments[idx].buffer);
+		pthread_mutex_lock(&reader.lock);
+		reader.n_dispatched++;
+		pthread_cond_broadcast(&reader.change);
+		pthread_mutex_unlock(&reader.lock);
+
+	}
+
+	pthread_mutex_lock(&reader.lock);
+	reader.must_stop = _CONFINI_TRUE_;
+	pthread_cond_broadcast(&reader.change);
+	pthread_mutex_unlock(&reader.lock);
+
+	while (n_workers) {
+
+		pthread_join(workers[--n_workers], (void **) 0);
+
+	}
+
+	pthread_cond_destroy(&reader.change);
+	pthread_mutex_destroy(&reader.lock);
+
+
+	/* \                                /\
+	\ */     free_and_exit:            /* \
+	 \/     ______________________     \ */
+
+
+	for (idx = 0; idx < reader.n_fragments; idx++) {
+
+		ini_load_buffer_free(&reader.fragments[idx].buffer);
+		free(reader.fragments[idx].name);
+
+	}
+
+	free(reader.fragments);
+
+	/*  No checks here, as there is nothing we can do about it...  */
+	closedir(dir);
+
+	return return_value;
+
+	#else
+
+	(void) dir_path;
+	(void) extension;
+	(void) format;
+	(void) f_file;
+	(void) f_init;
+	(void) f_foreach;
+	(void) user_data;
+
+	return CONFINI_ENOENT;
+
+	#endif
+
+}
+
+
+                                              /** @utility{ini_load_buffer_free} **/
+/**
+
+	@brief          Free the memory owned by a load buffer
+	@param          buffer          The buffer to free
+	@return         Nothing
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	After the call @p buffer is empty and can be reused.
+
+**/
+void ini_load_buffer_free (
+	IniLoadBuffer * const buffer
+) {
+
+	free(buffer->cache);
+	buffer->cache = (char *) 0;
+	buffer->size = 0;
+
+}
+
+
+                                            /** @utility{ini_load_buffer_detach} **/
+/**
+
+	@brief          Take over the memory owned by a load buffer
+	@param          buffer          The buffer to empty
+	@return         The memory previously owned by @p buffer (it can be `NULL`),
+	                which must be freed using `free()` when no longer needed
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	The strings dispatched by the last parse all point into the buffer: detaching
+	it keeps them in memory after the loader has returned, without copying them.
+	After the call @p buffer is empty and can be reused, but a new allocation will
+	be needed.
+
+	@warning    Each dispatch might overwrite data from previous dispatches: when
+	            relative section paths are supported (#INI_ABSOLUTE_AND_RELATIVE)
+	            the full path of a nested section is built in place, and can
+	            overwrite the nodes that follow its parent section. With all the
+	            other formats the dispatched strings remain intact.
+
+**/
+char * ini_load_buffer_detach (
+	IniLoadBuffer * const buffer
+) {
+
+	char * const cache = buffer->cache;
+
+	buffer->cache = (char *) 0;
+	buffer->size = 0;
+	return cache;
+
+}
+
+
+                                                      /** @utility{ini_compile} **/
+/**
+
+	@brief          Parse an INI file once and save the result as a binary image
+	                that can be loaded instantly
+	@param          ini_path        The path of the INI file
+	@param          image_path      The path of the image to create or replace
+	@param          format          The format of the INI file
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	The INI file is parsed using #load_ini_path() and every dispatch -- node type,
+	normalized section path, key or section name and value -- is stored in the
+	image, in the same order, together with a hash index of the keys. The strings
+	are referred to by offset, so that the image can be mapped at any address.
+	Consecutive nodes that belong to the same section share the same copy of the
+	section path.
+
+	The image can then be opened using #ini_image_open(), which involves no
+	parsing at all. The header of the image records the format of the INI file, a
+	version number, the byte order, the current #INI_GLOBAL_LOWERCASE_MODE (when
+	the format is case-insensitive), the current #INI_GLOBAL_IMPLICIT_VALUE (when
+	`implicit_is_not_empty` is set), and the size and modification time of the
+	INI file: an image that does not match any of these will be refused by
+	#ini_image_open(), so that it can be compiled again. Without the POSIX I/O API
+	only the size of the INI file is recorded.
+
+	With the POSIX I/O API the image is first written to a temporary file in the
+	same directory and then renamed, so that processes that open the image
+	concurrently never see it half-written. The image gets the same read and write
+	permissions as the INI file. Images cannot be larger than 4 GiB.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_ENOENT,
+	#CONFINI_ENOMEM, #CONFINI_EIO, #CONFINI_EOOR, #CONFINI_EFBIG.
+
+**/
+int ini_compile (
+	const char * const ini_path,
+	const char * const image_path,
+	const IniFormat format
+) {
+
+	struct image_builder builder = {
+		.nodes = (char *) 0,
+		.strings = (char *) 0,
+		.nodes_size = 0,
+		.strings_size = 0,
+		.n_nodes = 0,
+		.strings_len = 0,
+		.last_at_len = 0,
+		.status = CONFINI_SUCCESS
+	};
+
+	IniImage header = {
+		.byte_order = _CONFINI_IMAGE_BYTE_ORDER_,
+		.version = _CONFINI_IMAGE_VERSION_,
+		.format = (uint32_t) ini_fton(format),
+		.lowercase_mode =
+			(uint32_t) (!format.case_sensitive && INI_GLOBAL_LOWERCASE_MODE),
+		.implicit_offs = _CONFINI_IMAGE_NO_VALUE_,
+		.implicit_len = 0,
+		.reserved = 0
+	};
+
+	uint32_t * buckets = (uint32_t *) 0;
+	int return_value;
+	size_t idx;
+
+	/*  Stamp the INI file before parsing it: a later change makes it stale  */
+	if (
+		(return_value = stamp_image_source(ini_path, &header)) ||
+		/*  The root path, shared by all the nodes that precede the first section  */
+		(return_value = add_image_string(&builder, "", 0, &builder.last_at_offs))
+	) {
+
+		goto free_and_exit;
+
+	}
+
+	if (format.implicit_is_not_empty && INI_GLOBAL_IMPLICIT_VALUE) {
+
+		for (idx = 0; INI_GLOBAL_IMPLICIT_VALUE[idx]; idx++);
+
+		if (
+			(return_value = add_image_string(
+				&builder,
+				INI_GLOBAL_IMPLICIT_VALUE,
+				idx,
+				&header.implicit_offs
+			))
+		) {
+
+			goto free_and_exit;
+
+		}
+
+		header.implicit_len = (uint32_t) INI_GLOBAL_IMPLICIT_V_LEN;
+
+	}
+
+	if (
+		(return_value = load_ini_path(
+			ini_path,
+			format,
+			(IniStatsHandler) 0,
+			compile_image_node,
+			&builder
+		))
+	) {
+
+		if (return_value == CONFINI_FEINTR) {
+
+			return_value = builder.status;
+
+		}
+
+		goto free_and_exit;
+
+	}
+
+	struct image_node * const nodes = (struct image_node *) builder.nodes;
+	size_t n_keys = 0;
+	uint32_t n_buckets = 1, bucket;
+
+	for (idx = 0; idx < builder.n_nodes; idx++) {
+
+		n_keys += nodes[idx].type == INI_KEY;
+
+	}
+
+	/*  Keep the load factor of the hash table below 0.5  */
+	while (n_buckets < n_keys << 1 && n_buckets < 0x80000000U) {
+
+		n_buckets <<= 1;
+
+	}
+
+	const size_t strings_at =
+		sizeof(IniImage) + builder.n_nodes * sizeof(struct image_node) +
+		n_buckets * sizeof(uint32_t);
+
+	if (strings_at + builder.strings_len > 0xFFFFFFFFU) {
+
+		return_value = CONFINI_EFBIG;
+		goto free_and_exit;
+
+	}
+
+	if (!(buckets = (uint32_t *) malloc(n_buckets * sizeof(uint32_t)))) {
+
+		return_value = CONFINI_ENOMEM;
+		goto free_and_exit;
+
+	}
+
+	for (bucket = 0; bucket < n_buckets; bucket++) {
+
+		buckets[bucket] = 0;
+
+	}
+
+	/*  The last key of each chain comes first, so that later keys win  */
+	for (idx = 0; idx < builder.n_nodes; idx++) {
+
+		if (nodes[idx].type == INI_KEY) {
+
+			bucket = hash_image_key(
+				builder.strings + nodes[idx].at_offs,
+				nodes[idx].at_len,
+				builder.strings + nodes[idx].d_offs,
+				nodes[idx].d_len,
+				!format.case_sensitive
+			) & (n_buckets - 1);
+
+			nodes[idx].next = buckets[bucket];
+			buckets[bucket] = (uint32_t) idx + 1;
+
+		}
+
+	}
+
+	header.n_nodes = (uint32_t) builder.n_nodes;
+	header.n_buckets = n_buckets;
+	header.strings_at = (uint32_t) strings_at;
+	header.image_size = (uint32_t) (strings_at + builder.strings_len);
+
+	for (idx = 0; idx < sizeof(header.magic); idx++) {
+
+		header.magic[idx] = _CONFINI_IMAGE_MAGIC_[idx];
+
+	}
+
+	#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
+
+	const size_t path_len = strlen(image_path);
+	char * const tmp_path = (char *) malloc(path_len + 8);
+
+	if (!tmp_path) {
+
+		return_value = CONFINI_ENOMEM;
+		goto free_and_exit;
+
+	}
+
+	memcpy(tmp_path, image_path, path_len);
+	memcpy(tmp_path + path_len, ".XXXXXX", 8);
+
+	const int image_fd = mkstemp(tmp_path);
+	struct stat ini_stat;
+	FILE * image_file;
+
+	if (image_fd < 0) {
+
+		image_file = (FILE *) 0;
+
+	} else if (
+		/*  The image gets the same read/write permissions as the INI file  */
+		(
+			!stat(ini_path, &ini_stat) && fchmod(
+				image_fd,
+				ini_stat.st_mode & (
+					S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH
+				)
+			)
+		) || !(image_file = fdopen(image_fd, "wb"))
+	) {
+
+		/*  No checks here, as there is nothing we can do about it...  */
+		close(image_fd);
+		unlink(tmp_path);
+		image_file = (FILE *) 0;
+
+	}
+
+	#else
+
+	FILE * const image_file = fopen(image_path, "wb");
+
+	#endif
+
+	if (!image_file) {
+
+		return_value = CONFINI_ENOENT;
+
+	} else if (
+		fwrite(&header, sizeof(IniImage), 1, image_file) < 1 || (
+			/*  `nodes` is `NULL` when the INI file is empty  */
+			builder.n_nodes && fwrite(
+				nodes,
+				sizeof(struct image_node),
+				builder.n_nodes,
+				image_file
+			) < builder.n_nodes
+		) ||
+		fwrite(buckets, sizeof(uint32_t), n_buckets, image_file) < n_buckets ||
+		fwrite(builder.strings, 1, builder.strings_len, image_file) <
+			builder.strings_len
+	) {
+
+		/*  No checks here, as there is nothing we can do about it...  */
+		fclose(image_file);
+		return_value = CONFINI_EIO;
+
+	} else {
+
+		return_value = fclose(image_file) ? CONFINI_EIO : CONFINI_SUCCESS;
+
+	}
+
+	#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
+
+	if (image_file && (return_value || rename(tmp_path, image_path))) {
+
+		/*  No checks here, as there is nothing we can do about it...  */
+		unlink(tmp_path);
+
+		if (!return_value) {
+
+			return_value = CONFINI_EIO;
+
+		}
+
+	}
+
+	free(tmp_path);
+
+	#endif
+
+
+	/* \                                /\
+	\ */     free_and_exit:            /* \
+	 \/     ______________________     \ */
+
+
+	free(buckets);
+	free(builder.strings);
+	free(builder.nodes);
+	return return_value;
+
+}
+
+
+                                                   /** @utility{ini_image_open} **/
+/**
+
+	@brief          Open an image created by #ini_compile()
+	@param          ini_path        The path of the INI file the image must have
+	                                been compiled from, or `NULL` for not
+	                                checking it
+	@param          image_path      The path of the image
+	@param          format          The format that the image must have been
+	                                compiled with
+	@return         The image, or `NULL` if the image does not exist, could not
+	                be loaded, is corrupt or is stale
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	With the POSIX I/O API the image is mapped read-only into memory, so that
+	opening it costs only a few system calls and the pages are shared among all the
+	processes that use the same image; otherwise the image is read into the heap.
+	Either way no parsing takes place, and no further memory is ever allocated by
+	#ini_image_find() or #ini_image_get_node().
+
+	`NULL` is returned, and the image should be compiled again, if @p format does
+	not match the format the image was compiled with, if #INI_GLOBAL_LOWERCASE_MODE
+	or #INI_GLOBAL_IMPLICIT_VALUE have changed in a way that would change the
+	dispatches, if the image was written by an incompatible version of
+	**libconfini** or on a machine with a different byte order, or if the size or
+	the modification time of @p ini_path differ from those recorded by
+	#ini_compile(). Every node of the image is checked as well, so that a
+	truncated or corrupt image is refused instead of being read out of bounds;
+	this costs a pass over the nodes, but still no parsing.
+
+	The image must be closed using #ini_image_close().
+
+	@include topics/ini_compile.c
+
+**/
+const IniImage * ini_image_open (
+	const char * const ini_path,
+	const char * const image_path,
+	const IniFormat format
+) {
+
+	#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
+
+	const int image_fd = open(image_path, O_RDONLY);
+
+	if (image_fd < 0) {
+
+		return (const IniImage *) 0;
+
+	}
+
+	struct stat file_stat;
+	void * image = MAP_FAILED;
+
+	if (
+		!fstat(image_fd, &file_stat) &&
+		S_ISREG(file_stat.st_mode) &&
+		file_stat.st_size >= (off_t) sizeof(IniImage) &&
+		(uintmax_t) file_stat.st_size <= 0xFFFFFFFFU
+	) {
+
+		image = mmap(
+			(void *) 0,
+			(size_t) file_stat.st_size,
+			PROT_READ,
+			MAP_PRIVATE,
+			image_fd,
+			0
+		);
+
+	}
+
+	/*  No checks here, as there is nothing we can do about it...  */
+	close(image_fd);
+
+	if (image == MAP_FAILED) {
+
+		return (const IniImage *) 0;
+
+	}
+
+	if (
+		!image_is_valid(
+			(const IniImage *) image,
+			(size_t) file_stat.st_size,
+			format,
+			ini_path
+		)
+	) {
+
+		munmap(image, (size_t) file_stat.st_size);
+		return (const IniImage *) 0;
+
+	}
+
+	return (const IniImage *) image;
+
+	#else
+
+	FILE * const image_file = fopen(image_path, "rb");
+
+	if (!image_file) {
+
+		return (const IniImage *) 0;
+
+	}
+
+	long int image_size;
+	void * image = (void *) 0;
+
+	if (
+		!fseek(image_file, 0, SEEK_END) &&
+		(image_size = ftell(image_file)) >= (long int) sizeof(IniImage) &&
+		(unsigned long int) image_size <= 0xFFFFFFFFUL &&
+		(image = malloc((size_t) image_size))
+	) {
+
+		rewind(image_file);
+
+		if (fread(image, 1, (size_t) image_size, image_file) < (size_t) image_size) {
+
+			free(image);
+			image = (void *) 0;
+
+		}
+
+	}
+
+	/*  No checks here, as there is nothing we can do about it...  */
+	fclose(image_file);
+
+	if (
+		image &&
+		!image_is_valid(
+			(const IniImage *) image,
+			(size_t) image_size,
+			format,
+			ini_path
+		)
+	) {
+
+		free(image);
+		image = (void *) 0;
+
+	}
+
+	return (const IniImage *) image;
+
+	#endif
+
+}
+
+
+                                                  /** @utility{ini_image_close} **/
+/**
+
+	@brief          Close an image opened by #ini_image_open()
+	@param          image           The image to close, or `NULL`
+	@return         Nothing
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	All the strings obtained from @p image become invalid.
+
+**/
+void ini_image_close (
+	const IniImage * const image
+) {
+
+	if (!image) {
+
+		return;
+
+	}
+
+	#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
+
+	/*  No checks here, as there is nothing we can do about it...  */
+	munmap((void *) image, image->image_size);
+
+	#else
+
+	free((void *) image);
+
+	#endif
+
+}
+
+
+                                             /** @utility{ini_image_get_length} **/
+/**
+
+	@brief          Get the number of nodes stored in an image
+	@param          image           The image
+	@return         The number of nodes
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	The number returned equals the number of dispatches that the INI file produced
+	when it was compiled.
+
+**/
+size_t ini_image_get_length (
+	const IniImage * const image
+) {
+
+	return image->n_nodes;
+
+}
+
+
+                                               /** @utility{ini_image_get_node} **/
+/**
+
+	@brief          Get a node of an image by its position
+	@param          image           The image
+	@param          node_num        The position of the node (the same as the
+	                                `dispatch_id` it had when it was compiled)
+	@param          dest            The structure where to store the node
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	The strings pointed by @p dest belong to the image and are read-only.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_EOOR.
+
+**/
+int ini_image_get_node (
+	const IniImage * const image,
+	const size_t node_num,
+	IniImageNode * const dest
+) {
+
+	if (node_num >= image->n_nodes) {
+
+		return CONFINI_EOOR;
+
+	}
+
+	get_image_node(
+		image,
+		(const struct image_node *) (image + 1) + node_num,
+		dest
+	);
+
+	return CONFINI_SUCCESS;
+
+}
+
+
+                                                   /** @utility{ini_image_find} **/
+/**
+
+	@brief          Look up a key in an image
+	@param          image           The image
+	@param          section_path    The normalized section path (as dispatched
+	                                in `IniDispatch::append_to`), or `NULL` for
+	                                the root section
+	@param          key_name        The normalized key name (as dispatched in
+	                                `IniDispatch::data`)
+	@param          dest            The structure where to store the key found
+	@return         Zero if the key was found, otherwise an error code (see
+	                `enum` #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	The lookup uses the hash index of the image and takes constant time. The
+	strings are compared byte by byte, except that the case of the ASCII letters is
+	ignored if the image was compiled with a case-insensitive format. When the
+	same key appears more than once in the same section, the last one is returned.
+	Only active keys (#INI_KEY) can be found.
+
+	The strings pointed by @p dest belong to the image and are read-only.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_ENOENT.
+
+**/
+int ini_image_find (
+	const IniImage * const image,
+	const char * const section_path,
+	const char * const key_name,
+	IniImageNode * const dest
+) {
+
+	const char * const section = section_path ? section_path : "";
+	const char * const strings = (const char *) image + image->strings_at;
+	const struct image_node * const nodes = (const struct image_node *) (image + 1);
+	const uint32_t * const buckets = (const uint32_t *) (nodes + image->n_nodes);
+	const _CONFINI_CHARBOOL_ case_fold = !ini_ntof(image->format).case_sensitive;
+	const struct image_node * node;
+	size_t section_len = 0, key_len = 0, idx;
+	uint32_t node_num;
+
+	while (section[section_len]) {
+
+		section_len++;
+
+	}
+
+	while (key_name[key_len]) {
+
+		key_len++;
+
+	}
+
+	node_num = buckets[
+		hash_image_key(section, section_len, key_name, key_len, case_fold) &
+		(image->n_buckets - 1)
+	];
+
+	while (node_num) {
+
+		node = nodes + node_num - 1;
+		node_num = node->next;
+
+		if (node->at_len != section_len || node->d_len != key_len) {
+
+			continue;
+
+		}
+
+		for (idx = 0; idx < section_len; idx++) {
+
+			if (
+				case_fold ?
+					_CONFINI_CHR_CASEFOLD_(strings[node->at_offs + idx]) !=
+					_CONFINI_CHR_CASEFOLD_(section[idx])
+				:
+					strings[node->at_offs + idx] != section[idx]
+			) {
+
+				break;
+
+			}
+
+		}
+
+		if (idx < section_len) {
+
+			continue;
+
+		}
+
+		for (idx = 0; idx < key_len; idx++) {
+
+			if (
+				case_fold ?
+					_CONFINI_CHR_CASEFOLD_(strings[node->d_offs + idx]) !=
+					_CONFINI_CHR_CASEFOLD_(key_name[idx])
+				:
+					strings[node->d_offs + idx] != key_name[idx]
+			) {
+
+				break;
+
+			}
+
+		}
+
+		if (idx == key_len) {
+
+			get_image_node(image, node, dest);
+			return CONFINI_SUCCESS;
+
+		}
+
+	}
+
+	return CONFINI_ENOENT;
+
+}
+
+                                             /** @utility{ini_cache_set_budget} **/
+/**
+
+	@brief          Enable, resize or disable the parse cache of #load_ini_path()
+	@param          max_bytes       The maximum amount of memory that the cache
+	                                can use, or zero to disable the cache
+	@return         Nothing
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	The parse cache is disabled by default. When it is enabled, #load_ini_path()
+	stores the dispatches of every regular file it parses and, the next time the
+	same file is requested with the same format, replays them without reading and
+	parsing the file again. A file is considered unchanged as long as its device,
+	inode number, modification time and size are unchanged. The values passed to
+	#ini_global_set_implicit_value() and #ini_global_set_lowercase_mode() are part
+	of the key as well (the implicit value is compared by content, not by
+	address).
+
+	When storing a new file would exceed @p max_bytes, the least recently used
+	files are evicted first. Files that alone exceed @p max_bytes are never
+	stored. Shrinking the budget evicts immediately as many files as needed, and a
+	budget of zero empties the cache.
+
+	The cache is shared by all threads and is protected by a mutex; the dispatches
+	replayed are private copies that can be modified freely. While the cache is
+	disabled #load_ini_path() never takes the mutex.
+
+	@note   The cache relies on the modification time of the files, so a file
+	        rewritten with the same size within the timestamp granularity of its
+	        file system (or within the same second, on platforms that do not
+	        expose the nanoseconds) might not be detected as changed. Use
+	        #ini_cache_invalidate() after modifying a file in place.
+
+	@note   The parse cache is available only when the library is compiled with
+	        the POSIX I/O API; otherwise this function has no effect.
+
+**/
+void ini_cache_set_budget (
+	const size_t max_bytes
+) {
+
+	#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
+
+	pthread_mutex_lock(&parse_cache.lock);
+	_CONFINI_ATOMIC_SET_(parse_cache.budget, max_bytes);
+
+	while (parse_cache.last && parse_cache.cost > max_bytes) {
+
+		evict_cache_entry(parse_cache.last);
+
+	}
+
+	pthread_mutex_unlock(&parse_cache.lock);
+
+	#else
+
+	(void) max_bytes;
+
+	#endif
+
+}
+
+
+                                             /** @utility{ini_cache_invalidate} **/
+/**
+
+	@brief          Remove a file from the parse cache of #load_ini_path()
+	@param          path            The path of the file to forget, or `NULL` to
+	                                empty the cache
+	@return         Zero for success, otherwise an error code (see `enum`
+	                #ConfiniInterruptNo)
+
+	@note   This function is absent if the `--without-io-api` option was passed to
+	        the `configure` script when the library was compiled
+
+	All the entries of the file, whatever format they were parsed with, are
+	removed. Files are identified by device and inode number, so any path that
+	leads to the same file can be used. Dispatches that are being replayed when
+	this function is invoked are not affected.
+
+	Possible return values are: #CONFINI_SUCCESS, #CONFINI_ENOENT.
+
+**/
+int ini_cache_invalidate (
+	const char * const path
+) {
+
+	#if _CONFINI_IS_FLAVOR_(CONFINI_POSIX)
+
+	struct stat file_stat;
+
+	if (path && stat(path, &file_stat)) {
+
+		return CONFINI_ENOENT;
+
+	}
+
+	pthread_mutex_lock(&parse_cache.lock);
+
+	for (
+		struct cache_entry * entry =
+			path ?
+				*hash_cache_key(file_stat.st_dev, file_stat.st_ino)
+			:
+				parse_cache.first,
+		* next;
+			entry;
+		entry = next
+	) {
+
+		next = path ? entry->chain_next : entry->next;
+
+		if (
+			!path || (
+				entry->dev == file_stat.st_dev &&
+				entry->ino == file_stat.st_ino
+			)
+		) {
+
+			evict_cache_entry(entry);
+
+		}
+
+	}
+
+	pthread_mutex_unlock(&parse_cache.lock);
+
+	#else
+
+	(void) path;
+
+	#endif
+
+	return CONFINI_SUCCESS;
 
 }
 
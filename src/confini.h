@@ -146,6 +146,164 @@ typedef struct IniDispatch {
 } IniDispatch;
 
 
+/**
+    @brief  The node types, the sections and the keys a parser must dispatch,
+            and whether their values can be normalized lazily (see
+            #ini_reader_set_interest())
+**/
+typedef struct IniInterestSet {
+    unsigned int node_types;
+    const char * const * sections;
+    size_t n_sections;
+    const char * const * keys;
+    size_t n_keys;
+    bool lazy_values;
+} IniInterestSet;
+
+
+/**
+    @brief  Per-call replacements for #INI_GLOBAL_IMPLICIT_VALUE,
+            #INI_GLOBAL_IMPLICIT_V_LEN and #INI_GLOBAL_LOWERCASE_MODE (see
+            #strip_ini_cache_with_options())
+**/
+typedef struct IniParseOptions {
+    char * implicit_value;
+    size_t implicit_v_len;
+    bool lowercase_mode;
+} IniParseOptions;
+
+
+/**
+    @brief  State of a pull-style parser (see #ini_reader_init()); apart from
+            `dispatch`, all its members are private
+**/
+typedef struct IniReader {
+    IniDispatch dispatch;
+    char * ini_source;
+    char * curr_parent_str;
+    char * subparent_str;
+    char * real_parent_str;
+    size_t ini_length;
+    size_t scan_at;
+    size_t lshift;
+    size_t seg_at;
+    size_t seg_end;
+    size_t node_at;
+    size_t max_id;
+    size_t next_id;
+    size_t curr_parent_len;
+    size_t subparent_len;
+    size_t real_parent_len;
+    const IniInterestSet * interest;
+    const IniParseOptions * options;
+    const char * checked_parent_str;
+    size_t checked_parent_len;
+    int status;
+    uint_least8_t eol_n;
+    bool isnt_escaped;
+    bool parent_is_disabled;
+    bool parent_is_wanted;
+    bool valid_delimiter;
+    bool value_is_raw;
+} IniReader;
+
+
+
+/**
+    @brief  Caller-owned buffer that can be reused by the loading functions
+**/
+typedef struct IniLoadBuffer {
+    char * cache;
+    size_t size;
+} IniLoadBuffer;
+
+
+/**
+    @brief  Callback function for handling a file that belongs to a directory
+**/
+typedef int (* IniFileHandler) (
+    const char * file_name,
+    size_t file_num,
+    void * user_data
+);
+
+
+/**
+    @brief  Opaque handle of a compiled image of an INI file
+**/
+typedef struct IniImage IniImage;
+
+
+/**
+    @brief  A node stored in a compiled image
+**/
+typedef struct IniImageNode {
+    uint_least8_t type;
+    const char * data;
+    const char * value;
+    const char * append_to;
+    size_t d_len;
+    size_t v_len;
+    size_t at_len;
+} IniImageNode;
+
+
+
+
+/**
+    @brief  Opaque handle of a push-style streaming parser
+**/
+typedef struct IniStream IniStream;
+
+
+/**
+    @brief  A node stored in a tape (see #ini_tape_build()), whose offsets
+            refer to the buffer that has been parsed
+**/
+typedef struct IniTapeRecord {
+    uint_least32_t d_offs;
+    uint_least32_t d_len;
+    uint_least32_t v_offs;
+    uint_least32_t v_len;
+    uint_least32_t section;
+    uint_least8_t type;
+} IniTapeRecord;
+
+
+/**
+    @brief  A section path stored in a tape, whose offset refers to
+            `IniTape::paths`
+**/
+typedef struct IniTapeSection {
+    uint_least32_t offs;
+    uint_least32_t len;
+} IniTapeSection;
+
+
+/**
+    @brief  The nodes of an INI file, as stored by #ini_tape_build()
+**/
+typedef struct IniTape {
+    const char * ini_source;
+    const char * paths;
+    const IniTapeRecord * records;
+    const IniTapeSection * sections;
+    const uint_least32_t * keys;
+    size_t n_records;
+    size_t n_sections;
+    size_t n_keys;
+    IniFormat format;
+} IniTape;
+
+
+/**
+    @brief  Opaque handle of a document that can be parsed again incrementally
+            after each edit (see #ini_document_open())
+**/
+typedef struct IniDocument IniDocument;
+
+
+
 /**
     @brief  The unique ID of an INI format (24-bit maximum)
 **/
@@ -170,6 +328,28 @@ typedef int (* IniDispHandler) (
 );
 
 
+/**
+    @brief  Callback function for handling a block of #IniDispatch structures
+**/
+typedef int (* IniBatchHandler) (
+    IniDispatch * dispatches,
+    size_t n_dispatches,
+    void * user_data
+);
+
+
+/**
+    @brief  Callback function for handling an #IniDispatch structure that has
+            been added, removed or changed by an edit (see `enum`
+            #IniDeltaType)
+**/
+typedef int (* IniDeltaHandler) (
+    IniDispatch * dispatch,
+    int change,
+    void * user_data
+);
+
+
 /**
     @brief  Callback function for handling an INI string belonging to a
             sequence of INI strings
@@ -209,6 +389,136 @@ extern int strip_ini_cache (
     void * const user_data
 );
 
+extern int strip_ini_cache_with_options (
+    register char * const ini_source,
+    const size_t ini_length,
+    const IniFormat format,
+    const IniParseOptions * const options,
+    const IniStatsHandler f_init,
+    const IniDispHandler f_foreach,
+    void * const user_data
+);
+
+extern IniReader ini_reader_init (
+    char * const ini_source,
+    const size_t ini_length,
+    const IniFormat format
+);
+
+extern int ini_reader_next (
+    IniReader * const reader,
+    IniDispatch ** const dispatch
+);
+
+extern void ini_reader_set_interest (
+    IniReader * const reader,
+    const IniInterestSet * const interest
+);
+
+extern void ini_reader_set_options (
+    IniReader * const reader,
+    const IniParseOptions * const options
+);
+
+extern int strip_ini_cache_filtered (
+    register char * const ini_source,
+    const size_t ini_length,
+    const IniFormat format,
+    const IniInterestSet * const interest,
+    const IniDispHandler f_foreach,
+    void * const user_data
+);
+
+extern char * ini_dispatch_value (
+    IniDispatch * const dispatch
+);
+
+
+extern IniStream * ini_stream_open (
+    const IniFormat format,
+    const IniDispHandler f_foreach,
+    void * const user_data
+);
+
+
+extern void ini_stream_set_options (
+    IniStream * const stream,
+    const IniParseOptions * const options
+);
+
+
+extern int ini_stream_feed (
+    IniStream * const stream,
+    const char * const chunk,
+    const size_t chunk_len
+);
+
+
+extern int ini_stream_close (
+    IniStream * const stream
+);
+
+
+extern int strip_ini_const_cache (
+    const char * const ini_source,
+    const size_t ini_length,
+    const IniFormat format,
+    const IniStatsHandler f_init,
+    const IniDispHandler f_foreach,
+    void * const user_data
+);
+
+extern int strip_ini_cache_batch (
+    char * const ini_source,
+    const size_t ini_length,
+    const IniFormat format,
+    const IniStatsHandler f_init,
+    const IniBatchHandler f_batch,
+    size_t batch_size,
+    void * const user_data
+);
+
+extern int ini_tape_build (
+    char * const ini_source,
+    const size_t ini_length,
+    const IniFormat format,
+    const IniTape ** const dest
+);
+
+extern const IniTapeRecord * ini_tape_find (
+    const IniTape * const tape,
+    const char * const section_path,
+    const char * const key_name
+);
+
+extern void ini_tape_free (
+    const IniTape * const tape
+);
+
+extern int ini_document_open (
+    const char * const ini_source,
+    const size_t ini_length,
+    const IniFormat format,
+    const IniDeltaHandler f_delta,
+    void * const user_data,
+    IniDocument ** const dest
+);
+
+extern int ini_document_edit (
+    IniDocument * const document,
+    const size_t edit_at,
+    const size_t old_len,
+    const char * const new_text,
+    const size_t new_len,
+    const IniDeltaHandler f_delta,
+    void * const user_data
+);
+
+extern void ini_document_close (
+    IniDocument * const document
+);
+
+
 
 extern int load_ini_file (
     FILE * const ini_file,
@@ -228,6 +538,145 @@ extern int load_ini_path (
 );
 
 
+extern int load_ini_fd (
+    const int ini_fd,
+    const IniFormat format,
+    const IniStatsHandler f_init,
+    const IniDispHandler f_foreach,
+    void * const user_data
+);
+
+
+extern int load_ini_at (
+    const int dir_fd,
+    const char * const path,
+    const IniFormat format,
+    const IniStatsHandler f_init,
+    const IniDispHandler f_foreach,
+    void * const user_data
+);
+
+
+extern int load_ini_path_mmap (
+    const char * const path,
+    const IniFormat format,
+    const IniStatsHandler f_init,
+    const IniDispHandler f_foreach,
+    void * const user_data
+);
+
+
+extern int load_ini_file_buf (
+    FILE * const ini_file,
+    IniLoadBuffer * const buffer,
+    const IniFormat format,
+    const IniStatsHandler f_init,
+    const IniDispHandler f_foreach,
+    void * const user_data
+);
+
+
+extern int load_ini_path_buf (
+    const char * const path,
+    IniLoadBuffer * const buffer,
+    const IniFormat format,
+    const IniStatsHandler f_init,
+    const IniDispHandler f_foreach,
+    void * const user_data
+);
+
+
+extern int load_ini_fd_buf (
+    const int ini_fd,
+    IniLoadBuffer * const buffer,
+    const IniFormat format,
+    const IniStatsHandler f_init,
+    const IniDispHandler f_foreach,
+    void * const user_data
+);
+
+
+extern int load_ini_at_buf (
+    const int dir_fd,
+    const char * const path,
+    IniLoadBuffer * const buffer,
+    const IniFormat format,
+    const IniStatsHandler f_init,
+    const IniDispHandler f_foreach,
+    void * const user_data
+);
+
+
+extern int load_ini_dir (
+    const char * const dir_path,
+    const char * const extension,
+    const IniFormat format,
+    const IniFileHandler f_file,
+    const IniStatsHandler f_init,
+    const IniDispHandler f_foreach,
+    void * const user_data
+);
+
+
+extern void ini_load_buffer_free (
+    IniLoadBuffer * const buffer
+);
+
+
+extern char * ini_load_buffer_detach (
+    IniLoadBuffer * const buffer
+);
+
+
+extern int ini_compile (
+    const char * const ini_path,
+    const char * const image_path,
+    const IniFormat format
+);
+
+
+extern const IniImage * ini_image_open (
+    const char * const ini_path,
+    const char * const image_path,
+    const IniFormat format
+);
+
+
+extern void ini_image_close (
+    const IniImage * const image
+);
+
+
+extern size_t ini_image_get_length (
+    const IniImage * const image
+);
+
+
+extern int ini_image_get_node (
+    const IniImage * const image,
+    const size_t node_num,
+    IniImageNode * const dest
+);
+
+
+extern int ini_image_find (
+    const IniImage * const image,
+    const char * const section_path,
+    const char * const key_name,
+    IniImageNode * const dest
+);
+
+
+extern void ini_cache_set_budget (
+    const size_t max_bytes
+);
+
+
+extern int ini_cache_invalidate (
+    const char * const path
+);
+
+
 extern bool ini_string_match_ss (
     const char * const simple_string_a,
     const char * const simple_string_b,
@@ -401,6 +850,26 @@ extern double (* const ini_get_double) (
 #define CONFINI_ERROR 252
 
 
+/**
+    @brief  Default number of dispatches per block in #strip_ini_cache_batch()
+**/
+#define INI_DEFAULT_BATCH_SIZE 64
+
+
+/**
+    @brief  Value offset of the records of a tape that have no value (see
+            #ini_tape_build())
+**/
+#define INI_TAPE_NO_VALUE 0xFFFFFFFFU
+
+
+/**
+    @brief  Value offset of the records of a tape whose value is
+            #INI_GLOBAL_IMPLICIT_VALUE (see #ini_tape_build())
+**/
+#define INI_TAPE_IMPLICIT_VALUE 0xFFFFFFFEU
+
+
 /**
     @brief  Error codes
 **/
@@ -411,13 +880,15 @@ enum ConfiniInterruptNo {
                                  [value=1] **/
     CONFINI_FEINTR = 2,     /**< Interrupted by the user during `f_foreach()`
                                  [value=2] **/
+    CONFINI_EOF = 3,        /**< A pull-style parser has no more nodes to
+                                 read [value=3] **/
     CONFINI_ENOENT = 4,     /**< File inaccessible [value=4] **/
     CONFINI_ENOMEM = 5,     /**< Error allocating virtual memory [value=5] **/
     CONFINI_EIO = 6,        /**< Error reading the file [value=6] **/
     CONFINI_EOOR = 7,       /**< Out-of-range error: callbacks are more than
                                  expected [value=7] **/
-    CONFINI_EBADF = 8,      /**< The stream specified is not a seekable stream
-                                 [value=8] **/
+    CONFINI_EBADF = 8,      /**< The stream or the file descriptor specified
+                                 is not valid [value=8] **/
     CONFINI_EFBIG = 9,      /**< File too large [value=9] **/
     CONFINI_EROADDR = 10    /**< Address is read-only [value=10] **/
 };
@@ -452,6 +923,12 @@ enum IniNodeType {
 };
 
 
+/**
+    @brief  The bit that selects a node type in #IniInterestSet::node_types
+**/
+#define INI_NODE_MASK(NODE_TYPE) (1U << (NODE_TYPE))
+
+
 /**
     @brief  Common array and key-value delimiters (but a delimiter may also be
             any other ASCII character not present in this list)
@@ -521,6 +998,17 @@ enum IniMultiline {
 };
 
 
+/**
+    @brief  Changes reported by #ini_document_open() and #ini_document_edit()
+**/
+enum IniDeltaType {
+    INI_DELTA_ADDED = 0,    /**< The node is new [value=0] **/
+    INI_DELTA_REMOVED = 1,  /**< The node does not exist anymore [value=1] **/
+    INI_DELTA_CHANGED = 2   /**< The node has replaced a different node at
+                                 the same position [value=2] **/
+};
+
+
 /**
     @brief  A model format for standard INI files
 **/
@@ -0,0 +1,697 @@
+/*\
+|*|	tests/heap.c
+|*|
+|*|	This program is invoked by **GNU Make** (`make check`). It parses known
+|*|	buffers through the functions that allocate memory (which are absent when
+|*|	the library is compiled without the I/O API) and checks what they produce.
+\*/
+
+
+#include <stdio.h>
+#include <string.h>
+#ifndef TESTS_CONFINI_HEADER
+/*  possibly overridden via `-DTESTS_CONFINI_HEADER=[HEADER-NAME]`  */
+#define TESTS_CONFINI_HEADER "confini.h"
+#endif
+#include TESTS_CONFINI_HEADER
+
+
+/*  Each dispatch is printed as `TYPE|APPEND_TO|DATA|VALUE\n`  */
+struct dump {
+	char text[4096];
+	size_t len;
+};
+
+
+static int dump_node (IniDispatch * const dispatch, void * const v_dump) {
+
+	struct dump * const dump = (struct dump *) v_dump;
+
+	const int written = snprintf(
+		dump->text + dump->len,
+		sizeof(dump->text) - dump->len,
+		"%u|%s|%s|%s\n",
+		(unsigned int) dispatch->type,
+		dispatch->append_to,
+		dispatch->data,
+		dispatch->value ? dispatch->value : "(null)"
+	);
+
+	if (written < 0 || (size_t) written >= sizeof(dump->text) - dump->len) {
+
+		return 1;
+
+	}
+
+	dump->len += (size_t) written;
+	return 0;
+
+}
+
+
+/*  Compare a dump with what was expected  */
+static int check_dump (
+	const char * const what,
+	const int retval,
+	const struct dump * const dump,
+	const char * const expected
+) {
+
+	if (retval || strcmp(dump->text, expected)) {
+
+		printf(
+			"FAIL: %s\n  returned %d\n  expected:\n%s  got:\n%s",
+			what,
+			retval,
+			expected,
+			dump->text
+		);
+
+		return 1;
+
+	}
+
+	return 0;
+
+}
+
+
+/*  Print each record of a tape, with `*` for the implicit value  */
+static void dump_tape (const IniTape * const tape, struct dump * const dump) {
+
+	dump->len = 0;
+	dump->text[0] = '\0';
+
+	for (size_t idx = 0; idx < tape->n_records; idx++) {
+
+		const IniTapeRecord * const record = tape->records + idx;
+
+		dump->len += (size_t) snprintf(
+			dump->text + dump->len,
+			sizeof(dump->text) - dump->len,
+			"%u|%s|%s|%s\n",
+			(unsigned int) record->type,
+			tape->paths + tape->sections[record->section].offs,
+			tape->ini_source + record->d_offs,
+			record->v_offs == INI_TAPE_IMPLICIT_VALUE ?
+				"*"
+			: record->v_offs == INI_TAPE_NO_VALUE ?
+				"(null)"
+			:
+				tape->ini_source + record->v_offs
+		);
+
+	}
+
+}
+
+
+/*  `ini_tape_build()` and `ini_tape_find()`  */
+static int check_tape (void) {
+
+	static const char source[] = "a = 1\n[s]\nk = 2\nflag\n;off\n";
+	static char implicit[] = "yes";
+	char buffer[sizeof(source)];
+	IniFormat format = INI_DEFAULT_FORMAT;
+	const IniTape * tape;
+	const IniTapeRecord * record;
+	struct dump dump;
+	int failed = 0;
+
+	format.implicit_is_not_empty = 1;
+
+	/*  An implicit key must be recognized also when the implicit value is `NULL`  */
+	for (int round = 0; round < 2; round++) {
+
+		ini_global_set_implicit_value(round ? implicit : NULL, round ? 3 : 0);
+		memcpy(buffer, source, sizeof(source));
+
+		if (ini_tape_build(buffer, sizeof(source) - 1, format, &tape)) {
+
+			printf("FAIL: ini_tape_build()\n");
+			failed++;
+			continue;
+
+		}
+
+		dump_tape(tape, &dump);
+
+		failed += check_dump(
+			round ? "a tape with an implicit value" : "a tape with a NULL implicit value",
+			0,
+			&dump,
+			"2||a|1\n3||s|\n2|s|k|2\n2|s|flag|*\n4||off|\n"
+		);
+
+		if (
+			!(record = ini_tape_find(tape, "s", "k")) ||
+			strcmp(tape->ini_source + record->v_offs, "2") ||
+			!(record = ini_tape_find(tape, "", "a")) ||
+			strcmp(tape->ini_source + record->v_offs, "1") ||
+			!(record = ini_tape_find(tape, "s", "flag")) ||
+			record->v_offs != INI_TAPE_IMPLICIT_VALUE ||
+			ini_tape_find(tape, "s", "a") ||
+			ini_tape_find(tape, "s", "missing")
+		) {
+
+			printf("FAIL: ini_tape_find()\n");
+			failed++;
+
+		}
+
+		ini_tape_free(tape);
+
+	}
+
+	ini_global_set_implicit_value(NULL, 0);
+
+	/*  Without `implicit_is_not_empty` an implicit key has an empty value  */
+	memcpy(buffer, source, sizeof(source));
+
+	if (ini_tape_build(buffer, sizeof(source) - 1, INI_DEFAULT_FORMAT, &tape)) {
+
+		printf("FAIL: ini_tape_build()\n");
+		return failed + 1;
+
+	}
+
+	dump_tape(tape, &dump);
+
+	failed += check_dump(
+		"a tape without implicit values",
+		0,
+		&dump,
+		"2||a|1\n3||s|\n2|s|k|2\n2|s|flag|\n4||off|\n"
+	);
+
+	ini_tape_free(tape);
+	return failed;
+
+}
+
+
+/*  Parse a copy of @p source with `strip_ini_cache()`  */
+static int dump_whole (
+	const char * const source,
+	const IniFormat format,
+	struct dump * const dump
+) {
+
+	char buffer[1024];
+	const size_t len = strlen(source);
+
+	dump->len = 0;
+	dump->text[0] = '\0';
+	memcpy(buffer, source, len + 1);
+	return strip_ini_cache(buffer, len, format, NULL, dump_node, dump);
+
+}
+
+
+static int stop_at_second (IniDispatch * const dispatch, void * const v_dump) {
+
+	return dispatch->dispatch_id ? 1 : dump_node(dispatch, v_dump);
+
+}
+
+
+/*  `ini_stream_feed()` with chunks of every size  */
+static int check_stream (void) {
+
+	static const char source[] =
+		"\xEF\xBB\xBF; head\r\n[a]\r\nk = 'x  y' ; c\r\n[.b]\nmulti = 1 \\\n 2\n"
+		"#disabled = 3\n[c]\n\nlast";
+
+	const size_t len = sizeof(source) - 1;
+	struct dump expected, dump;
+	int failed = 0;
+
+	if (dump_whole(source, INI_DEFAULT_FORMAT, &expected)) {
+
+		printf("FAIL: strip_ini_cache() on the stream source\n");
+		return 1;
+
+	}
+
+	for (size_t chunk_len = 1; chunk_len <= len; chunk_len++) {
+
+		IniStream * const stream =
+			ini_stream_open(INI_DEFAULT_FORMAT, dump_node, &dump);
+
+		if (!stream) {
+
+			printf("FAIL: ini_stream_open()\n");
+			return failed + 1;
+
+		}
+
+		int retval = 0;
+
+		dump.len = 0;
+		dump.text[0] = '\0';
+
+		for (size_t at = 0; !retval && at < len; at += chunk_len) {
+
+			retval = ini_stream_feed(
+				stream,
+				source + at,
+				len - at < chunk_len ? len - at : chunk_len
+			);
+
+		}
+
+		const int close_err = ini_stream_close(stream);
+
+		if (retval || close_err || strcmp(dump.text, expected.text)) {
+
+			printf(
+				"FAIL: ini_stream_feed() with chunks of %zu bytes\n"
+				"  returned %d, %d\n  expected:\n%s  got:\n%s",
+				chunk_len,
+				retval,
+				close_err,
+				expected.text,
+				dump.text
+			);
+
+			failed++;
+
+		}
+
+	}
+
+	/*  An interrupted stream keeps failing  */
+	IniStream * const stream =
+		ini_stream_open(INI_DEFAULT_FORMAT, stop_at_second, &dump);
+
+	if (!stream) {
+
+		printf("FAIL: ini_stream_open()\n");
+		return failed + 1;
+
+	}
+
+	if (
+		ini_stream_feed(stream, source, len) != CONFINI_FEINTR ||
+		ini_stream_feed(stream, "x = 1\n", 6) != CONFINI_FEINTR ||
+		ini_stream_close(stream) != CONFINI_FEINTR
+	) {
+
+		printf("FAIL: an interrupted stream\n");
+		failed++;
+
+	}
+
+	return failed;
+
+}
+
+
+/*  `strip_ini_const_cache()` on sources that must stay untouched  */
+static int check_const_cache (void) {
+
+	static const char * const sources[] = {
+		"[a]\nk = 'x  y'\n[.b]\nj = 1 \\\n 2\n;c\n[c]\n#off = 3\nlast",
+		"\xEF\xBB\xBF" "a=1\r\n\r\n[s]  ; comment\r\nflag\r\nx = \"q\" \"\"\r\n",
+		""
+	};
+
+	struct dump expected, dump;
+	char copy[1024];
+	int failed = 0;
+
+	for (size_t idx = 0; idx < sizeof(sources) / sizeof(sources[0]); idx++) {
+
+		const size_t len = strlen(sources[idx]);
+
+		if (dump_whole(sources[idx], INI_DEFAULT_FORMAT, &expected)) {
+
+			printf("FAIL: strip_ini_cache() on a const cache source\n");
+			failed++;
+			continue;
+
+		}
+
+		memcpy(copy, sources[idx], len + 1);
+		dump.len = 0;
+		dump.text[0] = '\0';
+
+		failed += check_dump(
+			"strip_ini_const_cache()",
+			strip_ini_const_cache(
+				copy,
+				len,
+				INI_DEFAULT_FORMAT,
+				NULL,
+				dump_node,
+				&dump
+			),
+			&dump,
+			expected.text
+		);
+
+		if (memcmp(copy, sources[idx], len + 1)) {
+
+			printf("FAIL: strip_ini_const_cache() modified its source\n");
+			failed++;
+
+		}
+
+	}
+
+	return failed;
+
+}
+
+
+struct batch_dump {
+	struct dump dump;
+	char sizes[64];
+	size_t n_blocks;
+};
+
+
+static int dump_block (
+	IniDispatch * const dispatches,
+	const size_t n_dispatches,
+	void * const v_batch
+) {
+
+	struct batch_dump * const batch = (struct batch_dump * ) v_batch;
+
+	if (batch->n_blocks < sizeof(batch->sizes) - 1) {
+
+		batch->sizes[batch->n_blocks++] = (char) ('0' + n_dispatches);
+		batch->sizes[batch->n_blocks] = '\0';
+
+	}
+
+	for (size_t idx = 0; idx < n_dispatches; idx++) {
+
+		if (dump_node(dispatches + idx, &batch->dump)) {
+
+			return 1;
+
+		}
+
+	}
+
+	return 0;
+
+}
+
+
+static int stop_at_first_block (
+	IniDispatch * const dispatches,
+	const size_t n_dispatches,
+	void * const v_batch
+) {
+
+	dump_block(dispatches, n_dispatches, v_batch);
+	return 1;
+
+}
+
+
+/*  `strip_ini_cache_batch()`  */
+static int check_batch (void) {
+
+	static const struct {
+		const char * const source;
+		const size_t batch_size;
+		const char * const sizes;
+	} cases[] = {
+		{ "[a]\nk = 1\nj = 2\n[b]\nl = 3\n", 2, "221" },
+		{ "[a]\nk = 1\nj = 2\n[b]\nl = 3\n", 0, "5" },
+		{ "[a]\nk = 1\nj = 2\n[b]\nl = 3\n", 9, "5" },
+		/*  Blocks are delivered early after relative paths and within disabled sections  */
+		{ "[a]\n[.b]\nk = 1\nj = 2\n#[off]\n#x = 1\n#y = 2\n[c]\nz = 3\n", 4, "23112" }
+	};
+
+	char buffer[1024];
+	struct dump expected;
+	struct batch_dump batch;
+	int failed = 0;
+
+	for (size_t idx = 0; idx < sizeof(cases) / sizeof(cases[0]); idx++) {
+
+		const size_t len = strlen(cases[idx].source);
+
+		if (dump_whole(cases[idx].source, INI_DEFAULT_FORMAT, &expected)) {
+
+			printf("FAIL: strip_ini_cache() on a batch source\n");
+			failed++;
+			continue;
+
+		}
+
+		memcpy(buffer, cases[idx].source, len + 1);
+		batch.dump.len = 0;
+		batch.dump.text[0] = '\0';
+		batch.n_blocks = 0;
+		batch.sizes[0] = '\0';
+
+		failed += check_dump(
+			"strip_ini_cache_batch()",
+			strip_ini_cache_batch(
+				buffer,
+				len,
+				INI_DEFAULT_FORMAT,
+				NULL,
+				dump_block,
+				cases[idx].batch_size,
+				&batch
+			),
+			&batch.dump,
+			expected.text
+		);
+
+		if (strcmp(batch.sizes, cases[idx].sizes)) {
+
+			printf(
+				"FAIL: strip_ini_cache_batch() blocks\n  expected: %s\n  got: %s\n",
+				cases[idx].sizes,
+				batch.sizes
+			);
+
+			failed++;
+
+		}
+
+	}
+
+	memcpy(buffer, cases[0].source, strlen(cases[0].source) + 1);
+	batch.n_blocks = 0;
+
+	if (
+		strip_ini_cache_batch(
+			buffer,
+			strlen(cases[0].source),
+			INI_DEFAULT_FORMAT,
+			NULL,
+			stop_at_first_block,
+			2,
+			&batch
+		) != CONFINI_FEINTR || batch.n_blocks != 1
+	) {
+
+		printf("FAIL: strip_ini_cache_batch() was not interrupted\n");
+		failed++;
+
+	}
+
+	return failed;
+
+}
+
+
+static int dump_delta (
+	IniDispatch * const dispatch,
+	const int change,
+	void * const v_dump
+) {
+
+	struct dump * const dump = (struct dump *) v_dump;
+
+	const int written = snprintf(
+		dump->text + dump->len,
+		sizeof(dump->text) - dump->len,
+		"%d #%zu ",
+		change,
+		dispatch->dispatch_id
+	);
+
+	if (written < 0 || (size_t) written >= sizeof(dump->text) - dump->len) {
+
+		return 1;
+
+	}
+
+	dump->len += (size_t) written;
+	return dump_node(dispatch, dump);
+
+}
+
+
+/*  `ini_document_open()` and `ini_document_edit()`  */
+static int check_document (void) {
+
+	static const char source[] = "[a]\nk = 1\nj = 2\n[b]\nx = 3\n";
+
+	static const struct {
+		const char * const what;
+		const size_t edit_at;
+		const size_t old_len;
+		const char * const new_text;
+		const char * const expected;
+	} edits[] = {
+		{ "changing a value", 8, 1, "10", "2 #1 2|a|k|10\n" },
+		{
+			/*  The nodes of a renamed section change as well  */
+			"renaming a section", 1, 1, "c",
+			"2 #0 3||c|\n2 #1 2|c|k|10\n2 #2 2|c|j|2\n"
+		},
+		{ "appending a node", 27, 0, "y = 4\n", "0 #5 2|b|y|4\n" },
+		{ "removing a node", 11, 6, "", "1 #2 2|c|j|2\n" },
+		{ "inserting a node", 11, 0, "k = 1\n", "0 #2 2|c|k|1\n" },
+		{ "an edit that changes nothing", 11, 1, "k", "" },
+		{ "inserting a comment", 4, 0, "# c\n", "0 #1 4|| c|\n" },
+		{
+			/*  Comments have no parent, so they do not change  */
+			"renaming a section that contains a comment", 1, 1, "d",
+			"2 #0 3||d|\n2 #2 2|d|k|10\n2 #3 2|d|k|1\n"
+		}
+	};
+
+	IniDocument * document;
+	struct dump dump = { .len = 0 };
+	int failed = 0;
+
+	dump.text[0] = '\0';
+
+	failed += check_dump(
+		"ini_document_open()",
+		ini_document_open(
+			source,
+			sizeof(source) - 1,
+			INI_DEFAULT_FORMAT,
+			dump_delta,
+			&dump,
+			&document
+		),
+		&dump,
+		"0 #0 3||a|\n0 #1 2|a|k|1\n0 #2 2|a|j|2\n0 #3 3||b|\n0 #4 2|b|x|3\n"
+	);
+
+	if (failed) {
+
+		return failed;
+
+	}
+
+	for (size_t idx = 0; idx < sizeof(edits) / sizeof(edits[0]); idx++) {
+
+		dump.len = 0;
+		dump.text[0] = '\0';
+
+		failed += check_dump(
+			edits[idx].what,
+			ini_document_edit(
+				document,
+				edits[idx].edit_at,
+				edits[idx].old_len,
+				edits[idx].new_text,
+				strlen(edits[idx].new_text),
+				dump_delta,
+				&dump
+			),
+			&dump,
+			edits[idx].expected
+		);
+
+	}
+
+	if (ini_document_edit(document, 1000, 0, "", 0, dump_delta, &dump) != CONFINI_EOOR) {
+
+		printf("FAIL: ini_document_edit() out of range\n");
+		failed++;
+
+	}
+
+	ini_document_close(document);
+	return failed;
+
+}
+
+
+/*  `ini_stream_set_options()`  */
+static int check_stream_options (void) {
+
+	static const char source[] = "[Sec]\nKey = V\nFlag\n";
+	static char global_implicit[] = "no", own_implicit[] = "yes";
+	IniFormat format = INI_DEFAULT_FORMAT;
+	struct dump dump = { .len = 0 };
+	int retval = CONFINI_ENOMEM;
+
+	const IniParseOptions options = {
+		.implicit_value = own_implicit,
+		.implicit_v_len = 3,
+		.lowercase_mode = 1
+	};
+
+	format.implicit_is_not_empty = 1;
+	ini_global_set_implicit_value(global_implicit, 2);
+	dump.text[0] = '\0';
+
+	IniStream * const stream = ini_stream_open(format, dump_node, &dump);
+
+	if (stream) {
+
+		ini_stream_set_options(stream, &options);
+
+		/*  Split the source in the middle of a line  */
+		retval = ini_stream_feed(stream, source, 8);
+
+		if (!retval) {
+
+			retval = ini_stream_feed(stream, source + 8, sizeof(source) - 9);
+
+		}
+
+		const int close_err = ini_stream_close(stream);
+
+		if (!retval) {
+
+			retval = close_err;
+
+		}
+
+	}
+
+	ini_global_set_implicit_value(NULL, 0);
+
+	return check_dump(
+		"ini_stream_set_options()",
+		retval,
+		&dump,
+		"3||sec|\n2|sec|key|V\n2|sec|flag|yes\n"
+	);
+
+}
+
+
+int main () {
+
+	int failed = 0;
+
+	failed += check_stream();
+	failed += check_const_cache();
+	failed += check_batch();
+	failed += check_document();
+	failed += check_tape();
+	failed += check_stream_options();
+
+	return failed ? 1 : 0;
+
+}
+
@@ -0,0 +1,1273 @@
+/*\
+|*|	tests/loaders.c
+|*|
+|*|	This program is invoked by **GNU Make** (`make check`). It writes small INI
+|*|	files to the current directory, loads them through the I/O API and checks
+|*|	what is dispatched.
+\*/
+
+
+#ifdef TESTS_WITH_CONFINI_POSIX
+#define _POSIX_C_SOURCE 200809L
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef TESTS_CONFINI_HEADER
+/*  possibly overridden via `-DTESTS_CONFINI_HEADER=[HEADER-NAME]`  */
+#define TESTS_CONFINI_HEADER "confini.h"
+#endif
+#include TESTS_CONFINI_HEADER
+
+/*  Deprecated, but compiled images must still record it  */
+#undef INI_GLOBAL_LOWERCASE_MODE
+
+
+/*  Each dispatch is printed as `TYPE|APPEND_TO|DATA|VALUE\n`  */
+struct dump {
+	char text[4096];
+	size_t len;
+};
+
+
+static int dump_node (IniDispatch * const dispatch, void * const v_dump) {
+
+	struct dump * const dump = (struct dump *) v_dump;
+
+	const int written = snprintf(
+		dump->text + dump->len,
+		sizeof(dump->text) - dump->len,
+		"%u|%s|%s|%s\n",
+		(unsigned int) dispatch->type,
+		dispatch->append_to,
+		dispatch->data,
+		dispatch->value ? dispatch->value : "(null)"
+	);
+
+	if (written < 0 || (size_t) written >= sizeof(dump->text) - dump->len) {
+
+		return 1;
+
+	}
+
+	dump->len += (size_t) written;
+	return 0;
+
+}
+
+
+/*  Write @p len bytes of @p content to the file @p path  */
+static int write_file (
+	const char * const path,
+	const char * const content,
+	const size_t len
+) {
+
+	FILE * const ini_file = fopen(path, "wb");
+
+	if (!ini_file) {
+
+		printf("FAIL: cannot create %s\n", path);
+		return 1;
+
+	}
+
+	const size_t written = fwrite(content, 1, len, ini_file);
+
+	if (fclose(ini_file) || written != len) {
+
+		printf("FAIL: cannot write %s\n", path);
+		return 1;
+
+	}
+
+	return 0;
+
+}
+
+
+/*  Compare a dump with what was expected  */
+static int check_dump (
+	const char * const what,
+	const int retval,
+	const struct dump * const dump,
+	const char * const expected
+) {
+
+	if (retval || strcmp(dump->text, expected)) {
+
+		printf(
+			"FAIL: %s\n  returned %d\n  expected:\n%s  got:\n%s",
+			what,
+			retval,
+			expected,
+			dump->text
+		);
+
+		return 1;
+
+	}
+
+	return 0;
+
+}
+
+
+/*  A file whose middle node is longer than any initial buffer  */
+#define LONG_PADDING 30000
+
+static size_t make_long_file (char * const dest) {
+
+	static const char head[] = "[s]\nk = v\npad = ";
+	static const char tail[] = "x\nlast = 1\n";
+
+	memcpy(dest, head, sizeof(head) - 1);
+	memset(dest + sizeof(head) - 1, ' ', LONG_PADDING);
+	memcpy(dest + sizeof(head) - 1 + LONG_PADDING, tail, sizeof(tail));
+	return sizeof(head) - 1 + LONG_PADDING + sizeof(tail) - 1;
+
+}
+
+static const char long_file_dump[] = "3||s|\n2|s|k|v\n2|s|pad|x\n2|s|last|1\n";
+
+
+#if defined(TESTS_WITH_CONFINI_POSIX) && defined(__linux__)
+
+/*  Check whether a file whose name ends in @p name is mapped, and only readable  */
+static int is_mapped_read_only (const char * const name) {
+
+	char line[1024], perms[8];
+	const size_t name_len = strlen(name);
+	int found = 0;
+	FILE * const maps = fopen("/proc/self/maps", "r");
+
+	if (!maps) {
+
+		return 0;
+
+	}
+
+	while (!found && fgets(line, sizeof(line), maps)) {
+
+		size_t line_len = strlen(line);
+
+		while (line_len && line[line_len - 1] == '\n') {
+
+			line[--line_len] = '\0';
+
+		}
+
+		found =
+			line_len >= name_len &&
+			!strcmp(line + line_len - name_len, name) &&
+			sscanf(line, "%*x-%*x %7s", perms) == 1 &&
+			perms[0] == 'r' && perms[1] == '-';
+
+	}
+
+	fclose(maps);
+	return found;
+
+}
+
+#endif
+
+
+struct mmap_state {
+	struct dump dump;
+	size_t members;
+	int is_mapped;
+};
+
+
+static int count_mapped_members (
+	IniStatistics * const statistics,
+	void * const v_state
+) {
+
+	((struct mmap_state *) v_state)->members = statistics->members;
+	return 0;
+
+}
+
+
+static int check_mapped_node (IniDispatch * const dispatch, void * const v_state) {
+
+	struct mmap_state * const state = (struct mmap_state *) v_state;
+
+	#if defined(TESTS_WITH_CONFINI_POSIX) && defined(__linux__)
+
+	if (!dispatch->dispatch_id) {
+
+		state->is_mapped = is_mapped_read_only("loaders-mmap.ini");
+
+	}
+
+	#endif
+
+	return dump_node(dispatch, &state->dump);
+
+}
+
+
+/*  `load_ini_path_mmap()` with a file as large as one page  */
+static int check_mmap_loader (void) {
+
+	static const char head[] = "[section]\nkey = value\n";
+	static const char tail[] = "\nlast = yes";
+	char content[65536];
+	struct mmap_state state = { .dump = { .len = 0 }, .members = 0, .is_mapped = 0 };
+
+	#ifdef TESTS_WITH_CONFINI_POSIX
+	const long int page_size = sysconf(_SC_PAGESIZE);
+	const size_t file_size =
+		page_size > 0 && (size_t) page_size <= sizeof(content) ?
+			(size_t) page_size
+		:
+			4096;
+	#else
+	const size_t file_size = 4096;
+	#endif
+
+	/*  The last node ends exactly at the end of the page  */
+	memset(content, ' ', file_size);
+	memcpy(content, head, sizeof(head) - 1);
+	memcpy(content + file_size - sizeof(tail) + 1, tail, sizeof(tail) - 1);
+	state.dump.text[0] = '\0';
+
+	if (write_file("loaders-mmap.ini", content, file_size)) {
+
+		return 1;
+
+	}
+
+	int failed = check_dump(
+		"load_ini_path_mmap() on a page-sized file",
+		load_ini_path_mmap(
+			"loaders-mmap.ini",
+			INI_DEFAULT_FORMAT,
+			NULL,
+			check_mapped_node,
+			&state
+		),
+		&state.dump,
+		"3||section|\n2|section|key|value\n2|section|last|yes\n"
+	);
+
+	#if defined(TESTS_WITH_CONFINI_POSIX) && defined(__linux__)
+
+	if (!state.is_mapped) {
+
+		printf("FAIL: load_ini_path_mmap() did not map a page-sized file read-only\n");
+		failed++;
+
+	}
+
+	#endif
+
+	state.dump.len = 0;
+	state.dump.text[0] = '\0';
+
+	/*  A scan that counts the members before dispatching  */
+	failed += check_dump(
+		"load_ini_path_mmap() with an f_init callback",
+		load_ini_path_mmap(
+			"loaders-mmap.ini",
+			INI_DEFAULT_FORMAT,
+			count_mapped_members,
+			check_mapped_node,
+			&state
+		),
+		&state.dump,
+		"3||section|\n2|section|key|value\n2|section|last|yes\n"
+	);
+
+	if (state.members != 3) {
+
+		printf("FAIL: load_ini_path_mmap() counted %zu members\n", state.members);
+		failed++;
+
+	}
+
+	remove("loaders-mmap.ini");
+	return failed;
+
+}
+
+
+#ifdef TESTS_WITH_CONFINI_POSIX
+
+/*  Write @p len bytes of @p content into a new pipe and return its read end  */
+static int open_filled_pipe (const char * const content, const size_t len) {
+
+	int fds[2];
+	size_t written = 0;
+
+	if (pipe(fds)) {
+
+		return -1;
+
+	}
+
+	while (written < len) {
+
+		const ssize_t step = write(fds[1], content + written, len - written);
+
+		if (step < 1) {
+
+			break;
+
+		}
+
+		written += (size_t) step;
+
+	}
+
+	close(fds[1]);
+
+	if (written < len) {
+
+		close(fds[0]);
+		return -1;
+
+	}
+
+	return fds[0];
+
+}
+
+#endif
+
+
+/*  `load_ini_file()` and `load_ini_fd()` with streams that cannot seek  */
+static int check_nonseekable_streams (void) {
+
+	static char content[LONG_PADDING + 64];
+	const size_t len = make_long_file(content);
+	struct dump dump = { .len = 0 };
+	FILE * ini_file;
+	int failed = 0;
+
+	#ifdef TESTS_WITH_CONFINI_POSIX
+
+	int ini_fd = open_filled_pipe(content, len);
+
+	if (ini_fd < 0) {
+
+		printf("FAIL: cannot create a pipe\n");
+		return 1;
+
+	}
+
+	dump.text[0] = '\0';
+
+	failed += check_dump(
+		"load_ini_fd() on a pipe",
+		load_ini_fd(ini_fd, INI_DEFAULT_FORMAT, NULL, dump_node, &dump),
+		&dump,
+		long_file_dump
+	);
+
+	close(ini_fd);
+
+	if ((ini_fd = open_filled_pipe(content, len)) < 0 || !(ini_file = fdopen(ini_fd, "rb"))) {
+
+		printf("FAIL: cannot create a pipe\n");
+		return failed + 1;
+
+	}
+
+	dump.len = 0;
+	dump.text[0] = '\0';
+
+	failed += check_dump(
+		"load_ini_file() on a pipe",
+		load_ini_file(ini_file, INI_DEFAULT_FORMAT, NULL, dump_node, &dump),
+		&dump,
+		long_file_dump
+	);
+
+	fclose(ini_file);
+
+	#else
+
+	if (load_ini_fd(0, INI_DEFAULT_FORMAT, NULL, dump_node, &dump) != CONFINI_EBADF) {
+
+		printf("FAIL: load_ini_fd() without the POSIX I/O API\n");
+		failed++;
+
+	}
+
+	#endif
+
+	/*  A seekable stream is parsed whole, wherever its position is  */
+	if (
+		write_file("loaders-stream.ini", content, len) ||
+		!(ini_file = fopen("loaders-stream.ini", "rb"))
+	) {
+
+		printf("FAIL: cannot open loaders-stream.ini\n");
+		return failed + 1;
+
+	}
+
+	fseek(ini_file, 0, SEEK_END);
+	dump.len = 0;
+	dump.text[0] = '\0';
+
+	failed += check_dump(
+		"load_ini_file() at the end of a seekable stream",
+		load_ini_file(ini_file, INI_DEFAULT_FORMAT, NULL, dump_node, &dump),
+		&dump,
+		long_file_dump
+	);
+
+	fclose(ini_file);
+	remove("loaders-stream.ini");
+	return failed;
+
+}
+
+
+/*  `load_ini_fd()` on a regular file and `load_ini_at()`  */
+static int check_descriptors (void) {
+
+	struct dump dump = { .len = 0 };
+	int failed = 0;
+
+	dump.text[0] = '\0';
+
+	#ifdef TESTS_WITH_CONFINI_POSIX
+
+	if (mkdir("loaders-at", 0755) || write_file("loaders-at/f.ini", "[s]\nk = v\n", 10)) {
+
+		printf("FAIL: cannot create loaders-at\n");
+		return 1;
+
+	}
+
+	const int dir_fd = open("loaders-at", O_RDONLY | O_DIRECTORY);
+	const int ini_fd = open("loaders-at/f.ini", O_RDONLY);
+
+	if (dir_fd < 0 || ini_fd < 0) {
+
+		printf("FAIL: cannot open loaders-at\n");
+		return 1;
+
+	}
+
+	/*  The whole file is read, and the offset is left where it was  */
+	lseek(ini_fd, 4, SEEK_SET);
+
+	failed += check_dump(
+		"load_ini_fd() on a regular file",
+		load_ini_fd(ini_fd, INI_DEFAULT_FORMAT, NULL, dump_node, &dump),
+		&dump,
+		"3||s|\n2|s|k|v\n"
+	);
+
+	if (lseek(ini_fd, 0, SEEK_CUR) != 4) {
+
+		printf("FAIL: load_ini_fd() moved the file offset\n");
+		failed++;
+
+	}
+
+	dump.len = 0;
+	dump.text[0] = '\0';
+
+	failed += check_dump(
+		"load_ini_at() relative to a directory",
+		load_ini_at(dir_fd, "f.ini", INI_DEFAULT_FORMAT, NULL, dump_node, &dump),
+		&dump,
+		"3||s|\n2|s|k|v\n"
+	);
+
+	if (
+		load_ini_at(dir_fd, "missing.ini", INI_DEFAULT_FORMAT, NULL, NULL, NULL) !=
+			CONFINI_ENOENT
+	) {
+
+		printf("FAIL: load_ini_at() on a missing file\n");
+		failed++;
+
+	}
+
+	close(ini_fd);
+	close(dir_fd);
+	remove("loaders-at/f.ini");
+	rmdir("loaders-at");
+
+	#else
+
+	if (
+		load_ini_at(0, "f.ini", INI_DEFAULT_FORMAT, NULL, dump_node, &dump) !=
+			CONFINI_EBADF
+	) {
+
+		printf("FAIL: load_ini_at() without the POSIX I/O API\n");
+		failed++;
+
+	}
+
+	#endif
+
+	return failed;
+
+}
+
+
+#if defined(CONFINI_WITH_ZLIB) || defined(CONFINI_WITH_ZSTD)
+
+/*  Write a compressed file, then load it with `load_ini_path()`  */
+static int check_compressed_file (
+	const char * const what,
+	const char * const path,
+	const char * const content,
+	const size_t len,
+	const int expected_retval,
+	const char * const expected
+) {
+
+	struct dump dump = { .len = 0 };
+	int retval;
+
+	dump.text[0] = '\0';
+
+	if (write_file(path, content, len)) {
+
+		return 1;
+
+	}
+
+	retval = load_ini_path(path, INI_DEFAULT_FORMAT, NULL, dump_node, &dump);
+	remove(path);
+
+	if (expected_retval) {
+
+		if (retval != expected_retval) {
+
+			printf("FAIL: %s\n  returned %d\n", what, retval);
+			return 1;
+
+		}
+
+		return 0;
+
+	}
+
+	return check_dump(what, retval, &dump, expected);
+
+}
+
+#endif
+
+
+/*  The files compressed with gzip or Zstandard  */
+static int check_compressed_files (void) {
+
+	int failed = 0;
+
+	#ifdef CONFINI_WITH_ZLIB
+
+	/*  `printf '[z]\nk = gz\n' | gzip -9n`  */
+	static const char gzip_file[] =
+		"\x1f\x8b\x08\x00\x00\x00\x00\x00\x02\x03\x8b\xae\x8a\xe5\xca\x56"
+		"\xb0\x55\x48\xaf\xe2\x02\x00\xd3\x2f\xad\xcc\x0b\x00\x00\x00";
+
+	failed += check_compressed_file(
+		"load_ini_path() on a gzip file",
+		"loaders-gzip.ini.gz",
+		gzip_file,
+		sizeof(gzip_file) - 1,
+		CONFINI_SUCCESS,
+		"3||z|\n2|z|k|gz\n"
+	);
+
+	failed += check_compressed_file(
+		"load_ini_path() on a truncated gzip file",
+		"loaders-gzip.ini.gz",
+		gzip_file,
+		sizeof(gzip_file) - 9,
+		CONFINI_EIO,
+		NULL
+	);
+
+	#endif
+
+	#ifdef CONFINI_WITH_ZSTD
+
+	/*  `printf '[z]\nk = zstd\n' | zstd -19 --no-check`  */
+	static const char zstd_file[] =
+		"\x28\xb5\x2f\xfd\x00\x68\x69\x00\x00\x5b\x7a\x5d\x0a\x6b\x20\x3d"
+		"\x20\x7a\x73\x74\x64\x0a";
+
+	failed += check_compressed_file(
+		"load_ini_path() on a Zstandard file",
+		"loaders-zstd.ini.zst",
+		zstd_file,
+		sizeof(zstd_file) - 1,
+		CONFINI_SUCCESS,
+		"3||z|\n2|z|k|zstd\n"
+	);
+
+	failed += check_compressed_file(
+		"load_ini_path() on a truncated Zstandard file",
+		"loaders-zstd.ini.zst",
+		zstd_file,
+		sizeof(zstd_file) - 4,
+		CONFINI_EIO,
+		NULL
+	);
+
+	#endif
+
+	return failed;
+
+}
+
+
+/*  `load_ini_path_buf()` and the other functions of the load buffers  */
+static int check_load_buffer (void) {
+
+	static char content[LONG_PADDING + 64];
+	const size_t len = make_long_file(content);
+	IniLoadBuffer buffer = { NULL, 0 };
+	struct dump dump = { .len = 0 };
+	int failed = 0;
+
+	dump.text[0] = '\0';
+
+	if (
+		write_file("loaders-small.ini", "a = 1\n", 6) ||
+		write_file("loaders-large.ini", content, len)
+	) {
+
+		return 1;
+
+	}
+
+	failed += check_dump(
+		"load_ini_path_buf() with an empty buffer",
+		load_ini_path_buf(
+			"loaders-small.ini",
+			&buffer,
+			INI_DEFAULT_FORMAT,
+			NULL,
+			dump_node,
+			&dump
+		),
+		&dump,
+		"2||a|1\n"
+	);
+
+	/*  The buffer must grow, and then be reused as it is  */
+	dump.len = 0;
+	dump.text[0] = '\0';
+
+	failed += check_dump(
+		"load_ini_path_buf() with a buffer too small",
+		load_ini_path_buf(
+			"loaders-large.ini",
+			&buffer,
+			INI_DEFAULT_FORMAT,
+			NULL,
+			dump_node,
+			&dump
+		),
+		&dump,
+		long_file_dump
+	);
+
+	char * const grown_cache = buffer.cache;
+	const size_t grown_size = buffer.size;
+
+	dump.len = 0;
+	dump.text[0] = '\0';
+
+	failed += check_dump(
+		"load_ini_path_buf() with a buffer large enough",
+		load_ini_path_buf(
+			"loaders-small.ini",
+			&buffer,
+			INI_DEFAULT_FORMAT,
+			NULL,
+			dump_node,
+			&dump
+		),
+		&dump,
+		"2||a|1\n"
+	);
+
+	if (grown_size <= len || buffer.cache != grown_cache || buffer.size != grown_size) {
+
+		printf("FAIL: the load buffer was not grown once and reused\n");
+		failed++;
+
+	}
+
+	/*  The dispatched strings survive in the detached memory  */
+	char * const detached = ini_load_buffer_detach(&buffer);
+
+	if (detached != grown_cache || buffer.cache || buffer.size || strcmp(detached, "a")) {
+
+		printf("FAIL: ini_load_buffer_detach()\n");
+		failed++;
+
+	}
+
+	free(detached);
+	ini_load_buffer_free(&buffer);
+	remove("loaders-small.ini");
+	remove("loaders-large.ini");
+	return failed;
+
+}
+
+
+/*  Whether `ini_image_open()` accepts `loaders-image.img`  */
+static int image_opens (const char * const ini_path, const IniFormat format) {
+
+	const IniImage * const image =
+		ini_image_open(ini_path, "loaders-image.img", format);
+
+	ini_image_close(image);
+	return image != NULL;
+
+}
+
+
+/*  Images that no longer match their INI file or the library settings  */
+static int check_stale_images (void) {
+
+	static char implicit[] = "yes";
+	IniFormat format = INI_DEFAULT_FORMAT;
+	int failed = 0;
+
+	format.implicit_is_not_empty = 1;
+
+	if (
+		write_file("loaders-image.ini", "k = 1\nflag\n", 12) ||
+		ini_compile("loaders-image.ini", "loaders-image.img", format)
+	) {
+
+		printf("FAIL: cannot compile an image\n");
+		return 1;
+
+	}
+
+	ini_global_set_implicit_value(implicit, 3);
+
+	if (image_opens("loaders-image.ini", format)) {
+
+		printf("FAIL: ini_image_open() ignored the implicit value\n");
+		failed++;
+
+	}
+
+	if (
+		ini_compile("loaders-image.ini", "loaders-image.img", format) ||
+		!image_opens("loaders-image.ini", format)
+	) {
+
+		printf("FAIL: cannot open an image with an implicit value\n");
+		failed++;
+
+	}
+
+	/*  A different implicit value must be refused  */
+	implicit[0] = 'Y';
+
+	if (image_opens("loaders-image.ini", format)) {
+
+		printf("FAIL: ini_image_open() accepted a different implicit value\n");
+		failed++;
+
+	}
+
+	implicit[0] = 'y';
+	INI_GLOBAL_LOWERCASE_MODE = true;
+
+	if (image_opens("loaders-image.ini", format)) {
+
+		printf("FAIL: ini_image_open() ignored the lowercase mode\n");
+		failed++;
+
+	}
+
+	INI_GLOBAL_LOWERCASE_MODE = false;
+
+	#ifdef TESTS_WITH_CONFINI_POSIX
+
+	/*  Same size, different modification time  */
+	struct stat ini_stat;
+
+	if (!stat("loaders-image.ini", &ini_stat)) {
+
+		struct timespec times[2] = { ini_stat.st_atim, ini_stat.st_mtim };
+
+		times[1].tv_sec -= 10;
+
+		if (
+			!utimensat(AT_FDCWD, "loaders-image.ini", times, 0) &&
+			image_opens("loaders-image.ini", format)
+		) {
+
+			printf("FAIL: ini_image_open() ignored the modification time\n");
+			failed++;
+
+		}
+
+		if (!image_opens(NULL, format)) {
+
+			printf("FAIL: ini_image_open() checked a NULL INI path\n");
+			failed++;
+
+		}
+
+	}
+
+	#endif
+
+	if (
+		write_file("loaders-image.ini", "k = 10\nflag\n", 13) ||
+		image_opens("loaders-image.ini", format)
+	) {
+
+		printf("FAIL: ini_image_open() ignored the size of the INI file\n");
+		failed++;
+
+	}
+
+	/*  The last string of the image is no longer NUL-terminated  */
+	FILE * const image_file = fopen("loaders-image.img", "r+b");
+
+	const int write_err =
+		!image_file ||
+		fseek(image_file, -1L, SEEK_END) ||
+		fputc('x', image_file) == EOF;
+
+	if ((image_file && fclose(image_file)) || write_err) {
+
+		printf("FAIL: cannot corrupt the image\n");
+		failed++;
+
+	} else if (image_opens(NULL, format)) {
+
+		printf("FAIL: ini_image_open() accepted a corrupt image\n");
+		failed++;
+
+	}
+
+	ini_global_set_implicit_value(NULL, 0);
+	return failed;
+
+}
+
+
+/*  `ini_compile()` and the functions that read the images  */
+static int check_compiled_image (void) {
+
+	static const char content[] =
+		"a = 1\n[server]\nport = 80\n#port = 81\nhost = example\nport = 8080\n";
+
+	static const char expected[] =
+		"2||a|1\n3||server|\n2|server|port|80\n6|server|port|81\n"
+		"2|server|host|example\n2|server|port|8080\n";
+
+	const IniImage * image;
+	IniImageNode node;
+	struct dump dump = { .len = 0 };
+	int failed = 0;
+
+	dump.text[0] = '\0';
+
+	if (write_file("loaders-image.ini", content, sizeof(content) - 1)) {
+
+		return 1;
+
+	}
+
+	#ifdef TESTS_WITH_CONFINI_POSIX
+
+	/*  The image must get the permissions of the INI file  */
+	struct stat image_stat;
+
+	chmod("loaders-image.ini", S_IRUSR | S_IWUSR | S_IRGRP);
+
+	#endif
+
+	if (
+		ini_compile("loaders-image.ini", "loaders-image.img", INI_DEFAULT_FORMAT) ||
+		!(image = ini_image_open(
+			"loaders-image.ini",
+			"loaders-image.img",
+			INI_DEFAULT_FORMAT
+		))
+	) {
+
+		printf("FAIL: cannot compile and open an image\n");
+		remove("loaders-image.ini");
+		remove("loaders-image.img");
+		return 1;
+
+	}
+
+	#ifdef TESTS_WITH_CONFINI_POSIX
+
+	if (
+		stat("loaders-image.img", &image_stat) ||
+		(image_stat.st_mode & 0777) != (S_IRUSR | S_IWUSR | S_IRGRP)
+	) {
+
+		printf("FAIL: ini_compile() did not copy the mode of the INI file\n");
+		failed++;
+
+	}
+
+	#endif
+
+	for (size_t idx = 0; idx < ini_image_get_length(image); idx++) {
+
+		if (ini_image_get_node(image, idx, &node)) {
+
+			break;
+
+		}
+
+		dump.len += (size_t) snprintf(
+			dump.text + dump.len,
+			sizeof(dump.text) - dump.len,
+			"%u|%s|%s|%s\n",
+			(unsigned int) node.type,
+			node.append_to,
+			node.data,
+			node.value
+		);
+
+	}
+
+	failed += check_dump("ini_image_get_node()", 0, &dump, expected);
+
+	if (
+		ini_image_get_node(image, ini_image_get_length(image), &node) !=
+			CONFINI_EOOR
+	) {
+
+		printf("FAIL: ini_image_get_node() past the last node\n");
+		failed++;
+
+	}
+
+	if (
+		ini_image_find(image, "server", "port", &node) ||
+		strcmp(node.value, "8080") ||
+		ini_image_find(image, NULL, "a", &node) ||
+		strcmp(node.value, "1") ||
+		ini_image_find(image, "server", "missing", &node) != CONFINI_ENOENT
+	) {
+
+		printf("FAIL: ini_image_find()\n");
+		failed++;
+
+	}
+
+	ini_image_close(image);
+
+	/*  An empty INI file gives an empty image  */
+	if (
+		write_file("loaders-image.ini", "", 0) ||
+		ini_compile("loaders-image.ini", "loaders-image.img", INI_DEFAULT_FORMAT) ||
+		!(image = ini_image_open(
+			"loaders-image.ini",
+			"loaders-image.img",
+			INI_DEFAULT_FORMAT
+		))
+	) {
+
+		printf("FAIL: cannot compile an empty INI file\n");
+		failed++;
+
+	} else {
+
+		if (ini_image_get_length(image)) {
+
+			printf("FAIL: the image of an empty INI file is not empty\n");
+			failed++;
+
+		}
+
+		ini_image_close(image);
+
+	}
+
+	/*  A different format must be refused  */
+	if (ini_image_open(NULL, "loaders-image.img", INI_UNIXLIKE_FORMAT)) {
+
+		printf("FAIL: ini_image_open() accepted a different format\n");
+		failed++;
+
+	}
+
+	failed += check_stale_images();
+	remove("loaders-image.ini");
+	remove("loaders-image.img");
+	return failed;
+
+}
+
+
+#ifdef TESTS_WITH_CONFINI_POSIX
+
+static int dump_file_name (
+	const char * const file_name,
+	const size_t file_num,
+	void * const v_dump
+) {
+
+	struct dump * const dump = (struct dump *) v_dump;
+
+	dump->len += (size_t) snprintf(
+		dump->text + dump->len,
+		sizeof(dump->text) - dump->len,
+		"%zu:%s\n",
+		file_num,
+		file_name
+	);
+
+	return 0;
+
+}
+
+
+static int dump_node_with_id (IniDispatch * const dispatch, void * const v_dump) {
+
+	struct dump * const dump = (struct dump *) v_dump;
+
+	dump->len += (size_t) snprintf(
+		dump->text + dump->len,
+		sizeof(dump->text) - dump->len,
+		"#%zu ",
+		dispatch->dispatch_id
+	);
+
+	return dump_node(dispatch, v_dump);
+
+}
+
+#endif
+
+
+/*  `load_ini_dir()` on a `conf.d`-style directory  */
+static int check_directory (void) {
+
+	#ifdef TESTS_WITH_CONFINI_POSIX
+
+	static const char * const files[][2] = {
+		{ "loaders-dir/b.conf", "x = 3\n" },
+		{ "loaders-dir/a.conf", "x = 1\ny = 2\n" },
+		{ "loaders-dir/.hidden.conf", "hidden = 1\n" },
+		{ "loaders-dir/c.txt", "ignored = 1\n" }
+	};
+
+	const size_t n_files = sizeof(files) / sizeof(files[0]);
+	struct dump dump = { .len = 0 };
+	int failed = 0;
+
+	dump.text[0] = '\0';
+
+	if (mkdir("loaders-dir", 0755) || mkdir("loaders-dir/d.conf", 0755)) {
+
+		printf("FAIL: cannot create loaders-dir\n");
+		return 1;
+
+	}
+
+	for (size_t idx = 0; idx < n_files; idx++) {
+
+		failed += write_file(files[idx][0], files[idx][1], strlen(files[idx][1]));
+
+	}
+
+	failed += check_dump(
+		"load_ini_dir()",
+		load_ini_dir(
+			"loaders-dir",
+			".conf",
+			INI_DEFAULT_FORMAT,
+			dump_file_name,
+			NULL,
+			dump_node_with_id,
+			&dump
+		),
+		&dump,
+		"0:a.conf\n#0 2||x|1\n#1 2||y|2\n1:b.conf\n#0 2||x|3\n"
+	);
+
+	dump.len = 0;
+	dump.text[0] = '\0';
+
+	failed += check_dump(
+		"load_ini_dir() without an extension",
+		load_ini_dir(
+			"loaders-dir",
+			NULL,
+			INI_DEFAULT_FORMAT,
+			dump_file_name,
+			NULL,
+			NULL,
+			&dump
+		),
+		&dump,
+		"0:a.conf\n1:b.conf\n2:c.txt\n"
+	);
+
+	for (size_t idx = 0; idx < n_files; idx++) {
+
+		remove(files[idx][0]);
+
+	}
+
+	rmdir("loaders-dir/d.conf");
+	rmdir("loaders-dir");
+
+	if (
+		load_ini_dir("loaders-dir", NULL, INI_DEFAULT_FORMAT, NULL, NULL, NULL, NULL) !=
+			CONFINI_ENOENT
+	) {
+
+		printf("FAIL: load_ini_dir() on a missing directory\n");
+		failed++;
+
+	}
+
+	return failed;
+
+	#else
+
+	if (load_ini_dir(".", NULL, INI_DEFAULT_FORMAT, NULL, NULL, NULL, NULL) != CONFINI_ENOENT) {
+
+		printf("FAIL: load_ini_dir() without the POSIX I/O API\n");
+		return 1;
+
+	}
+
+	return 0;
+
+	#endif
+
+}
+
+
+#ifdef TESTS_WITH_CONFINI_POSIX
+
+/*  Rewrite a file keeping its size and its modification time  */
+static int rewrite_file_in_place (
+	const char * const path,
+	const char * const content,
+	const size_t len
+) {
+
+	struct stat file_stat;
+
+	if (stat(path, &file_stat) || write_file(path, content, len)) {
+
+		return 1;
+
+	}
+
+	const struct timespec times[2] = { file_stat.st_atim, file_stat.st_mtim };
+
+	return utimensat(AT_FDCWD, path, times, 0);
+
+}
+
+
+/*  The parse cache of `load_ini_path()`  */
+static int check_parse_cache (void) {
+
+	static char implicit_1[] = "yes", implicit_2[] = "yes";
+	IniFormat format = INI_DEFAULT_FORMAT;
+	struct dump dump;
+	int failed = 0;
+
+	format.implicit_is_not_empty = 1;
+	ini_global_set_implicit_value(implicit_1, 3);
+	ini_cache_set_budget(65536);
+
+	if (write_file("loaders-cache.ini", "k = 1\nflag\n", 12)) {
+
+		return 1;
+
+	}
+
+	#define __LOAD_AND_CHECK__(WHAT, EXPECTED) \
+		dump.len = 0; \
+		dump.text[0] = '\0'; \
+		failed += check_dump( \
+			WHAT, \
+			load_ini_path("loaders-cache.ini", format, NULL, dump_node, &dump), \
+			&dump, \
+			EXPECTED \
+		);
+
+	__LOAD_AND_CHECK__("load_ini_path() with the cache", "2||k|1\n2||flag|yes\n")
+
+	/*  An unchanged stat means a hit: the old content is replayed  */
+	rewrite_file_in_place("loaders-cache.ini", "k = 2\nflag\n", 12);
+	__LOAD_AND_CHECK__("a parse cache hit", "2||k|1\n2||flag|yes\n")
+
+	/*  Another copy of the same implicit value is still a hit  */
+	ini_global_set_implicit_value(implicit_2, 3);
+	__LOAD_AND_CHECK__("a hit with an equal implicit value", "2||k|1\n2||flag|yes\n")
+
+	/*  A different implicit value is a miss  */
+	implicit_2[0] = 'Y';
+	__LOAD_AND_CHECK__("a miss after changing the implicit value", "2||k|2\n2||flag|Yes\n")
+
+	rewrite_file_in_place("loaders-cache.ini", "k = 3\nflag\n", 12);
+
+	if (ini_cache_invalidate("loaders-cache.ini")) {
+
+		printf("FAIL: ini_cache_invalidate()\n");
+		failed++;
+
+	}
+
+	__LOAD_AND_CHECK__("a miss after ini_cache_invalidate()", "2||k|3\n2||flag|Yes\n")
+
+	#undef __LOAD_AND_CHECK__
+
+	ini_cache_set_budget(0);
+	ini_global_set_implicit_value(NULL, 0);
+	remove("loaders-cache.ini");
+	return failed;
+
+}
+
+#endif
+
+
+int main () {
+
+	int failed = 0;
+
+	failed += check_mmap_loader();
+	failed += check_nonseekable_streams();
+	failed += check_descriptors();
+	failed += check_compressed_files();
+	failed += check_load_buffer();
+	failed += check_directory();
+	failed += check_compiled_image();
+
+	#ifdef TESTS_WITH_CONFINI_POSIX
+	failed += check_parse_cache();
+	#endif
+
+	return failed ? 1 : 0;
+
+}
+
@@ -0,0 +1,782 @@
+/*\
+|*|	tests/parser.c
+|*|
+|*|	This program is invoked by **GNU Make** (`make check`). It parses known
+|*|	buffers and compares what is dispatched with what is expected.
+\*/
+
+
+#include <stdio.h>
+#include <string.h>
+#ifndef TESTS_CONFINI_HEADER
+/*  possibly overridden via `-DTESTS_CONFINI_HEADER=[HEADER-NAME]`  */
+#define TESTS_CONFINI_HEADER "confini.h"
+#endif
+#include TESTS_CONFINI_HEADER
+
+#define UNUSED(ARG) (void)(ARG)
+
+
+/*  Each dispatch is printed as `TYPE|APPEND_TO|DATA|VALUE\n`  */
+struct dump {
+	char text[4096];
+	size_t len;
+};
+
+
+struct parse_case {
+	const char * const source;
+	const char * const expected;
+};
+
+
+static int dump_node (IniDispatch * const dispatch, void * const v_dump) {
+
+	struct dump * const dump = (struct dump *) v_dump;
+
+	const int written = snprintf(
+		dump->text + dump->len,
+		sizeof(dump->text) - dump->len,
+		"%u|%s|%s|%s\n",
+		(unsigned int) dispatch->type,
+		dispatch->append_to,
+		dispatch->data,
+		dispatch->value ? dispatch->value : "(null)"
+	);
+
+	if (written < 0 || (size_t) written >= sizeof(dump->text) - dump->len) {
+
+		return 1;
+
+	}
+
+	dump->len += (size_t) written;
+	return 0;
+
+}
+
+
+static int count_nodes (IniStatistics * const statistics, void * const v_dump) {
+
+	UNUSED(statistics);
+	UNUSED(v_dump);
+	return 0;
+
+}
+
+
+/*  Parse @p source and compare the dispatches with @p expected  */
+static int check_parse (
+	const char * const source,
+	const IniFormat format,
+	const IniStatsHandler f_init,
+	const char * const expected
+) {
+
+	char buffer[1024];
+	struct dump dump = { .len = 0 };
+	const size_t len = strlen(source);
+
+	dump.text[0] = '\0';
+	memcpy(buffer, source, len + 1);
+
+	const int retval =
+		strip_ini_cache(buffer, len, format, f_init, dump_node, &dump);
+
+	if (retval || strcmp(dump.text, expected)) {
+
+		printf(
+			"FAIL: %s with%s f_init\n  returned %d\n  expected:\n%s  got:\n%s",
+			source,
+			f_init ? "" : "out",
+			retval,
+			expected,
+			dump.text
+		);
+
+		return 1;
+
+	}
+
+	return 0;
+
+}
+
+
+/*  Run a table of cases both with and without an `f_init` callback  */
+static int check_cases (
+	const struct parse_case * const cases,
+	const size_t n_cases,
+	const IniFormat format
+) {
+
+	int failed = 0;
+
+	for (size_t idx = 0; idx < n_cases; idx++) {
+
+		failed += check_parse(
+			cases[idx].source,
+			format,
+			count_nodes,
+			cases[idx].expected
+		);
+
+		failed += check_parse(
+			cases[idx].source,
+			format,
+			NULL,
+			cases[idx].expected
+		);
+
+	}
+
+	return failed;
+
+}
+
+
+/*  Nodes that begin with escaped backslashes or with quotes  */
+static int check_leading_backslashes (void) {
+
+	static const struct parse_case cases[] = {
+		{ "\\\\a=' #b'", "2||\\\\a|' #b'\n" },
+		{ "\\\\\\\\k = \"v #w\"", "2||\\\\\\\\k|\"v #w\"\n" },
+		{ "\\\\ a = 1\nb = 2", "2||\\\\ a|1\n2||b|2\n" },
+		{ "\\\\\nb = 2", "2||\\\\|\n2||b|2\n" },
+		{ "\\\\#x = 1", "2||\\\\#x|1\n" },
+		{ "'\\\\'a = 1\nb = 2", "2||'\\\\'a|1\n2||b|2\n" }
+	};
+
+	return check_cases(
+		cases,
+		sizeof(cases) / sizeof(struct parse_case),
+		INI_DEFAULT_FORMAT
+	);
+
+}
+
+
+/*  Keys that begin with the delimiter  */
+static int check_empty_key_names (void) {
+
+	/*  A delimiter that is also the escape character cannot delimit  */
+	static const struct parse_case cases[] = {
+		{ "\\===", "2||\\===|\n" },
+		{ "k\\v\n#\\x\n", "2||k\\v|\n6||\\x|\n" }
+	};
+
+	IniFormat format = INI_DEFAULT_FORMAT;
+
+	format.delimiter_symbol = '\\';
+	format.no_spaces_in_names = 1;
+	format.disabled_can_be_implicit = 1;
+
+	return check_cases(
+		cases,
+		sizeof(cases) / sizeof(struct parse_case),
+		format
+	);
+
+}
+
+
+/*  `ini_reader_next()` must read what `strip_ini_cache()` dispatches  */
+static int check_reader (void) {
+
+	static const char * const sources[] = {
+		"\xEF\xBB\xBF; head\r\n[a]\r\nk = 'x  y' ; c\r\n[.b]\nmulti = 1 \\\n 2\n"
+			"#disabled = 3\n[c]\n\nlast",
+		"[a]\n[.b]\n[.c]\nk = 1\n#[off]\n#[.sub]\n#key = 2\nback = 3\n",
+		"\\\\a=' #b'\n\\\\#x = 1",
+		"",
+		"\n\n  \n"
+	};
+
+	char buffer[1024];
+	struct dump expected, dump;
+	IniDispatch * dispatch;
+	int failed = 0;
+
+	for (size_t idx = 0; idx < sizeof(sources) / sizeof(sources[0]); idx++) {
+
+		const size_t len = strlen(sources[idx]);
+		int retval;
+
+		memcpy(buffer, sources[idx], len + 1);
+		expected.len = 0;
+		expected.text[0] = '\0';
+
+		if (strip_ini_cache(buffer, len, INI_DEFAULT_FORMAT, NULL, dump_node, &expected)) {
+
+			printf("FAIL: strip_ini_cache() on a reader source\n");
+			failed++;
+			continue;
+
+		}
+
+		memcpy(buffer, sources[idx], len + 1);
+		dump.len = 0;
+		dump.text[0] = '\0';
+
+		IniReader reader = ini_reader_init(buffer, len, INI_DEFAULT_FORMAT);
+
+		while (!(retval = ini_reader_next(&reader, &dispatch))) {
+
+			dump_node(dispatch, &dump);
+
+		}
+
+		/*  The end of the buffer is sticky, and leaves the dispatch untouched  */
+		dispatch = NULL;
+
+		if (
+			retval != CONFINI_EOF ||
+			ini_reader_next(&reader, &dispatch) != CONFINI_EOF ||
+			dispatch
+		) {
+
+			printf("FAIL: ini_reader_next() at the end of the buffer\n");
+			failed++;
+
+		}
+
+		if (strcmp(dump.text, expected.text)) {
+
+			printf(
+				"FAIL: ini_reader_next()\n  expected:\n%s  got:\n%s",
+				expected.text,
+				dump.text
+			);
+
+			failed++;
+
+		}
+
+	}
+
+	return failed;
+
+}
+
+
+static int dump_node_with_id (IniDispatch * const dispatch, void * const v_dump) {
+
+	struct dump * const dump = (struct dump *) v_dump;
+
+	const int written = snprintf(
+		dump->text + dump->len,
+		sizeof(dump->text) - dump->len,
+		"#%zu ",
+		dispatch->dispatch_id
+	);
+
+	if (written < 0 || (size_t) written >= sizeof(dump->text) - dump->len) {
+
+		return 1;
+
+	}
+
+	dump->len += (size_t) written;
+	return dump_node(dispatch, v_dump);
+
+}
+
+
+/*  Parse @p source with `strip_ini_cache_filtered()`  */
+static int check_filtered (
+	const char * const what,
+	const char * const source,
+	const IniInterestSet * const interest,
+	const char * const expected
+) {
+
+	char buffer[1024];
+	struct dump dump = { .len = 0 };
+	const size_t len = strlen(source);
+
+	dump.text[0] = '\0';
+	memcpy(buffer, source, len + 1);
+
+	const int retval = strip_ini_cache_filtered(
+		buffer,
+		len,
+		INI_DEFAULT_FORMAT,
+		interest,
+		dump_node_with_id,
+		&dump
+	);
+
+	if (retval || strcmp(dump.text, expected)) {
+
+		printf(
+			"FAIL: %s\n  returned %d\n  expected:\n%s  got:\n%s",
+			what,
+			retval,
+			expected,
+			dump.text
+		);
+
+		return 1;
+
+	}
+
+	return 0;
+
+}
+
+
+/*  Interest sets made of sections and keys  */
+static int check_interest_sets (void) {
+
+	static const char source[] =
+		"k = 0\nk0 = 0\n[a]\nk = 1\nj = 2\n;note\n[b]\nK = 3\n[A]\nK = 4\n"
+		"[a.c]\nk = 5\n#k = 6\n";
+
+	static const char * const sections[] = { "", "a" };
+	static const char * const keys[] = { "k" };
+	char buffer[sizeof(source)];
+	IniDispatch * dispatch;
+	struct dump dump = { .len = 0 };
+	int failed = 0;
+
+	const IniInterestSet by_section = {
+		.sections = sections + 1,
+		.n_sections = 1
+	};
+
+	const IniInterestSet by_key = {
+		.keys = keys,
+		.n_keys = 1
+	};
+
+	const IniInterestSet by_both = {
+		.sections = sections,
+		.n_sections = 2,
+		.keys = keys,
+		.n_keys = 1
+	};
+
+	/*  Section nodes are never filtered by section, and IDs count what is read  */
+	failed += check_filtered(
+		"an interest set of sections",
+		source,
+		&by_section,
+		"#0 3||a|\n#1 2|a|k|1\n#2 2|a|j|2\n#3 4||note|\n#4 3||b|\n#5 3||A|\n"
+		"#6 2|A|K|4\n#7 3||a.c|\n"
+	);
+
+	failed += check_filtered(
+		"an interest set of keys",
+		source,
+		&by_key,
+		"#0 2||k|0\n#1 3||a|\n#2 2|a|k|1\n#3 4||note|\n#4 3||b|\n#5 2|b|K|3\n"
+		"#6 3||A|\n#7 2|A|K|4\n#8 3||a.c|\n#9 2|a.c|k|5\n#10 6|a.c|k|6\n"
+	);
+
+	failed += check_filtered(
+		"an interest set of sections and keys",
+		source,
+		&by_both,
+		"#0 2||k|0\n#1 3||a|\n#2 2|a|k|1\n#3 4||note|\n#4 3||b|\n#5 3||A|\n"
+		"#6 2|A|K|4\n#7 3||a.c|\n"
+	);
+
+	failed += check_filtered("a NULL interest set", "a = 1\n[s]", NULL, "#0 2||a|1\n#1 3||s|\n");
+
+	/*  The interest set of a reader can change between two nodes  */
+	memcpy(buffer, source, sizeof(source));
+	dump.text[0] = '\0';
+
+	IniReader reader = ini_reader_init(buffer, sizeof(source) - 1, INI_DEFAULT_FORMAT);
+
+	ini_reader_set_interest(&reader, &by_key);
+
+	for (int idx = 0; !ini_reader_next(&reader, &dispatch); idx++) {
+
+		dump_node_with_id(dispatch, &dump);
+
+		if (idx == 2) {
+
+			ini_reader_set_interest(&reader, &by_section);
+
+		}
+
+	}
+
+	if (
+		strcmp(
+			dump.text,
+			"#0 2||k|0\n#1 3||a|\n#2 2|a|k|1\n#3 2|a|j|2\n#4 4||note|\n#5 3||b|\n"
+			"#6 3||A|\n#7 2|A|K|4\n#8 3||a.c|\n"
+		)
+	) {
+
+		printf("FAIL: ini_reader_set_interest() between two nodes\n  got:\n%s", dump.text);
+		failed++;
+
+	}
+
+	return failed;
+
+}
+
+
+/*  Interest sets made of node types  */
+static int check_node_type_masks (void) {
+
+	static const char source[] =
+		"k = 0\n[a]\nk = 1\n;note\n#j = 2\n#[off]\n#z = 9\n[.b]\nx = 3 # tail\n";
+
+	static const struct {
+		const char * const what;
+		const IniInterestSet interest;
+		const char * const expected;
+	} cases[] = {
+		{
+			/*  Sections that are not read still give the path of the other nodes  */
+			"a mask of keys",
+			{ .node_types = INI_NODE_MASK(INI_KEY) | INI_NODE_MASK(INI_DISABLED_KEY) },
+			"#0 2||k|0\n#1 2|a|k|1\n#2 6|a|j|2\n#3 6|off|z|9\n#4 2|a.b|x|3\n"
+		}, {
+			"a mask of sections",
+			{ .node_types = INI_NODE_MASK(INI_SECTION) | INI_NODE_MASK(INI_DISABLED_SECTION) },
+			"#0 3||a|\n#1 7||off|\n#2 3|a|.b|\n"
+		}, {
+			"a mask of comments",
+			{ .node_types = INI_NODE_MASK(INI_COMMENT) | INI_NODE_MASK(INI_INLINE_COMMENT) },
+			"#0 4||note|\n#1 5|| tail|\n"
+		}, {
+			"an empty mask",
+			{ .node_types = 0 },
+			"#0 2||k|0\n#1 3||a|\n#2 2|a|k|1\n#3 4||note|\n#4 6|a|j|2\n#5 7||off|\n"
+			"#6 6|off|z|9\n#7 3|a|.b|\n#8 2|a.b|x|3\n#9 5|| tail|\n"
+		}
+	};
+
+	int failed = 0;
+
+	for (size_t idx = 0; idx < sizeof(cases) / sizeof(cases[0]); idx++) {
+
+		failed += check_filtered(
+			cases[idx].what,
+			source,
+			&cases[idx].interest,
+			cases[idx].expected
+		);
+
+	}
+
+	return failed;
+
+}
+
+
+/*  Each value is printed raw, then normalized by `ini_dispatch_value()`  */
+static int dump_lazy_node (IniDispatch * const dispatch, void * const v_dump) {
+
+	struct dump * const dump = (struct dump *) v_dump;
+
+	const int written = snprintf(
+		dump->text + dump->len,
+		sizeof(dump->text) - dump->len,
+		"%s|[%s]|",
+		dispatch->data,
+		dispatch->value
+	);
+
+	if (written < 0 || (size_t) written >= sizeof(dump->text) - dump->len) {
+
+		return 1;
+
+	}
+
+	dump->len += (size_t) written;
+
+	const char * const value = ini_dispatch_value(dispatch);
+	const size_t v_len = dispatch->v_len;
+
+	/*  A second invocation must not normalize the value again  */
+	if (ini_dispatch_value(dispatch) != value || dispatch->v_len != v_len) {
+
+		return 1;
+
+	}
+
+	return dump_node(dispatch, dump);
+
+}
+
+
+/*  `IniInterestSet::lazy_values` and `ini_dispatch_value()`  */
+static int check_lazy_values (void) {
+
+	static const char source[] =
+		"[s]\nk =  'a  b'   c  \nj = \\\n x\nq = \"a\\\"b\"\nflag\n";
+
+	static const char * const keys[] = { "k", "j", "q", "flag" };
+
+	static const char expected[] =
+		"s|[]|3||s|\n"
+		"k|[  'a  b'   c  ]|2|s|k|'a  b' c\n"
+		"j|[ \n x]|2|s|j|x\n"
+		"q|[ \"a\\\"b\"]|2|s|q|\"a\\\"b\"\n"
+		"flag|[]|2|s|flag|\n";
+
+	const IniInterestSet interest = {
+		.node_types = 0,
+		.keys = keys,
+		.n_keys = sizeof(keys) / sizeof(const char *),
+		.lazy_values = 1
+	};
+
+	char buffer[sizeof(source)];
+	struct dump dump = { .len = 0 };
+
+	dump.text[0] = '\0';
+	memcpy(buffer, source, sizeof(source));
+
+	const int retval = strip_ini_cache_filtered(
+		buffer,
+		sizeof(source) - 1,
+		INI_DEFAULT_FORMAT,
+		&interest,
+		dump_lazy_node,
+		&dump
+	);
+
+	if (retval || strcmp(dump.text, expected)) {
+
+		printf(
+			"FAIL: lazy values\n  returned %d\n  expected:\n%s  got:\n%s",
+			retval,
+			expected,
+			dump.text
+		);
+
+		return 1;
+
+	}
+
+	return 0;
+
+}
+
+
+/*  `strip_ini_cache_with_options()` and `ini_reader_set_options()`  */
+static int check_parse_options (void) {
+
+	static const char source[] = "[Sec]\nKey = V\nFlag\n";
+	static char global_implicit[] = "no", own_implicit[] = "yes";
+	static const char expected[] = "3||sec|\n2|sec|key|V\n2|sec|flag|yes\n";
+	char buffer[sizeof(source)];
+	IniFormat format = INI_DEFAULT_FORMAT;
+	IniDispatch * dispatch;
+	struct dump dump = { .len = 0 };
+	int failed = 0;
+
+	const IniParseOptions options = {
+		.implicit_value = own_implicit,
+		.implicit_v_len = 3,
+		.lowercase_mode = 1
+	};
+
+	/*  The global settings must be ignored  */
+	format.implicit_is_not_empty = 1;
+	ini_global_set_implicit_value(global_implicit, 2);
+	dump.text[0] = '\0';
+	memcpy(buffer, source, sizeof(source));
+
+	const int retval = strip_ini_cache_with_options(
+		buffer,
+		sizeof(source) - 1,
+		format,
+		&options,
+		count_nodes,
+		dump_node,
+		&dump
+	);
+
+	if (retval || strcmp(dump.text, expected)) {
+
+		printf(
+			"FAIL: strip_ini_cache_with_options()\n  returned %d\n"
+			"  expected:\n%s  got:\n%s",
+			retval,
+			expected,
+			dump.text
+		);
+
+		failed++;
+
+	}
+
+	memcpy(buffer, source, sizeof(source));
+	dump.len = 0;
+	dump.text[0] = '\0';
+
+	IniReader reader = ini_reader_init(buffer, sizeof(source) - 1, format);
+
+	ini_reader_set_options(&reader, &options);
+
+	while (!ini_reader_next(&reader, &dispatch) && !dump_node(dispatch, &dump)) {
+
+		if (dispatch->v_len == 3 && dispatch->value != own_implicit) {
+
+			printf("FAIL: ini_reader_set_options() did not share the implicit value\n");
+			failed++;
+
+		}
+
+	}
+
+	if (strcmp(dump.text, expected)) {
+
+		printf(
+			"FAIL: ini_reader_set_options()\n  expected:\n%s  got:\n%s",
+			expected,
+			dump.text
+		);
+
+		failed++;
+
+	}
+
+	ini_global_set_implicit_value(NULL, 0);
+	return failed;
+
+}
+
+
+/*  Formats without escape sequences, which take a dedicated path  */
+static int check_formats_without_escapes (void) {
+
+	/*  Backslashes and quotes are plain characters, and lines are never joined  */
+	static const char quotes_and_paths[] =
+		"[ a . b ]\n"
+		"a\\b = \"x  y\" ; tail\n"
+		"'q' = 'it''s'   here\n"
+		"#c = \\\n"
+		"[.sub]\n"
+		"key with  spaces =   many    spaces   in   value  \n";
+
+	/*  Lines longer than a vector of the scanners  */
+	static const char comments[] =
+		"k = value;no space comment\n"
+		"j = v # c ; d\n"
+		";  comment \\ line\n"
+		"# [dis . sec]\n"
+		"#x = 1\n"
+		"0123456789abcdef0123 = 0123456789abcdef0123456789 ; long comment here\n";
+
+	static const char unterminated[] =
+		"[sec\\tion]\n"
+		"name=\"unterminated\n"
+		"\\\\=\\\\\n"
+		"last line without newline";
+
+	static const struct parse_case collapsed[] = {
+		{
+			quotes_and_paths,
+			"3||a.b|\n"
+			"2|a.b|a\\b|\"x y\"\n"
+			"5|| tail|\n"
+			"2|a.b|'q'|'it''s' here\n"
+			"6|a.b|c|\\\n"
+			"3|a.b|.sub|\n"
+			"2|a.b.sub|key with spaces|many spaces in value\n"
+		}, {
+			comments,
+			"2||k|value;no space comment\n"
+			"2||j|v\n"
+			"5|| c ; d|\n"
+			"4||  comment \\ line|\n"
+			"4|| [dis . sec]|\n"
+			"6||x|1\n"
+			"2||0123456789abcdef0123|0123456789abcdef0123456789\n"
+			"5|| long comment here|\n"
+		}, {
+			unterminated,
+			"3||sec\\tion|\n"
+			"2|sec\\tion|name|\"unterminated\n"
+			"2|sec\\tion|\\\\|\\\\\n"
+			"2|sec\\tion|last line without newline|\n"
+		}
+	};
+
+	static const struct parse_case not_collapsed[] = {
+		{
+			quotes_and_paths,
+			"3||a.b|\n"
+			"2|a.b|a\\b|\"x  y\"\n"
+			"5|| tail|\n"
+			"2|a.b|'q'|'it''s'   here\n"
+			"6|a.b|c|\\\n"
+			"3|a.b|.sub|\n"
+			"2|a.b.sub|key with spaces|many    spaces   in   value\n"
+		}
+	};
+
+	static const struct parse_case space_delimited[] = {
+		{
+			unterminated,
+			"3||sec\\tion|\n"
+			"2|sec\\tion|name=\"unterminated|\n"
+			"2|sec\\tion|\\\\=\\\\|\n"
+			"2|sec\\tion|last|line without newline\n"
+		}
+	};
+
+	IniFormat format = INI_DEFAULT_FORMAT;
+	int failed = 0;
+
+	format.multiline_nodes = INI_NO_MULTILINE;
+	format.no_double_quotes = 1;
+	format.no_single_quotes = 1;
+
+	failed += check_cases(
+		collapsed,
+		sizeof(collapsed) / sizeof(struct parse_case),
+		format
+	);
+
+	format.do_not_collapse_values = 1;
+
+	failed += check_cases(
+		not_collapsed,
+		sizeof(not_collapsed) / sizeof(struct parse_case),
+		format
+	);
+
+	format = INI_UNIXLIKE_FORMAT;
+	format.multiline_nodes = INI_NO_MULTILINE;
+	format.no_double_quotes = 1;
+	format.no_single_quotes = 1;
+
+	failed += check_cases(
+		space_delimited,
+		sizeof(space_delimited) / sizeof(struct parse_case),
+		format
+	);
+
+	return failed;
+
+}
+
+
+int main () {
+
+	int failed = 0;
+
+	failed += check_leading_backslashes();
+	failed += check_empty_key_names();
+	failed += check_reader();
+	failed += check_interest_sets();
+	failed += check_node_type_masks();
+	failed += check_lazy_values();
+	failed += check_parse_options();
+	failed += check_formats_without_escapes();
+
+	return failed ? 1 : 0;
+
+}
+
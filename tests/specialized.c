@@ -0,0 +1,235 @@
+/*\
+|*|	tests/specialized.c
+|*|
+|*|	This program is invoked by **GNU Make** (`make check`). It compiles the
+|*|	library source together with format-specialized copies of the parser (see
+|*|	the `--with-specialized-formats` option of the `configure` script) and checks
+|*|	that each copy dispatches exactly what the generic parser dispatches.
+\*/
+
+
+#ifndef CONFINI_SPECIALIZED_FORMATS
+/*  possibly overridden via `--with-specialized-formats=LIST`  */
+#define CONFINI_SPECIALIZED_FORMATS 61, 0, 71354, 15515709, 1205053, 245760
+#endif
+#include "confini.c"
+#include <stdio.h>
+#include <string.h>
+
+
+/*  Each dispatch is printed as `ID:TYPE|APPEND_TO|DATA|VALUE\n`  */
+struct dump {
+	char text[4096];
+	size_t len;
+	size_t members;
+};
+
+
+static int count_members (IniStatistics * const statistics, void * const v_dump) {
+
+	((struct dump *) v_dump)->members = statistics->members;
+	return 0;
+
+}
+
+
+static int dump_node (IniDispatch * const dispatch, void * const v_dump) {
+
+	struct dump * const dump = (struct dump *) v_dump;
+
+	const int written = snprintf(
+		dump->text + dump->len,
+		sizeof(dump->text) - dump->len,
+		"%zu:%u|%s|%s|%s\n",
+		dispatch->dispatch_id,
+		(unsigned int) dispatch->type,
+		dispatch->append_to,
+		dispatch->data,
+		dispatch->value ? dispatch->value : "(null)"
+	);
+
+	if (written < 0 || (size_t) written >= sizeof(dump->text) - dump->len) {
+
+		return 1;
+
+	}
+
+	dump->len += (size_t) written;
+	return 0;
+
+}
+
+
+/*  A specialized copy of the parser and the format it was specialized for  */
+struct specialized_parser {
+	IniFormatNum format_num;
+	int (* parse) (
+		char * ini_source,
+		size_t ini_length,
+		const IniParseOptions * options,
+		IniStatsHandler f_init,
+		IniDispHandler f_foreach,
+		void * user_data
+	);
+};
+
+
+#define __SPECIALIZED_PARSER__(FORMAT_NUM) \
+	{ FORMAT_NUM, strip_ini_cache_##FORMAT_NUM },
+
+static const struct specialized_parser parsers[] = {
+	_CONFINI_FOR_EACH_(__SPECIALIZED_PARSER__, CONFINI_SPECIALIZED_FORMATS)
+};
+
+#undef __SPECIALIZED_PARSER__
+
+
+/*  The buffers parsed with each format (the lengths include any inner `NUL`)  */
+static const struct {
+	const char * source;
+	size_t len;
+} cases[] = {
+	#define __CASE__(SOURCE) { SOURCE, sizeof(SOURCE) - 1 }
+	__CASE__(
+		"a = 1\n[sec]\nk=v\n; comment\n# disabled = 2\n[.sub]\n"
+		"q = \"x  y\" # inline\nK = upper\n"
+	),
+	__CASE__(
+		"k = a \\\n  b\n#off = c \\\n d\n;; a block\n;; of comments\n"
+		"#[off.section]\n#x : 1\n"
+	),
+	__CASE__(
+		"\xEF\xBB\xBF[ S ]\r\nKey : 'va;l'\r\nx=\"\"\r\nimplicit\r\n"
+		"  indented key = spaced   value  \r\n"
+	),
+	__CASE__(
+		"[a.b]\n[.c]\n[..d]\nx=1\n#[off]\n#y=2\n[ one two ]\nz\n"
+		"[\"quoted.path\".e]\nw = 2\n"
+	),
+	__CASE__(
+		"k = \\\"q\\\" \\\\ w\n\\==\nsp ace = v\n# \\\n cont\n"
+		"a:b=c\nd e f\n"
+	),
+	__CASE__("\n\n;\n#\n[\n]\n= v\n::\n  \t\f\v\n[]\n#\\\n"),
+	__CASE__("k\0= v\nx = y\0\0\nz = \"w\0\"\n")
+	#undef __CASE__
+};
+
+
+/*  Parse a case with both the generic and the specialized parser  */
+static int check_case (
+	const struct specialized_parser * const parser,
+	const size_t case_num,
+	const IniParseOptions * const options,
+	const IniStatsHandler f_init
+) {
+
+	const IniFormat format = ini_ntof(parser->format_num);
+	char buffers[3][256];
+	struct dump dumps[3];
+	int retvals[3];
+
+	for (size_t idx = 0; idx < 3; idx++) {
+
+		memcpy(buffers[idx], cases[case_num].source, cases[case_num].len + 1);
+		dumps[idx].len = 0;
+		dumps[idx].members = 0;
+		dumps[idx].text[0] = '\0';
+
+	}
+
+	retvals[0] = tokenize_ini_cache(
+		buffers[0],
+		cases[case_num].len,
+		format,
+		options,
+		f_init,
+		dump_node,
+		dumps
+	);
+
+	retvals[1] = parser->parse(
+		buffers[1],
+		cases[case_num].len,
+		options,
+		f_init,
+		dump_node,
+		dumps + 1
+	);
+
+	/*  The public function must pick the specialized copy by itself  */
+	retvals[2] = strip_ini_cache_with_options(
+		buffers[2],
+		cases[case_num].len,
+		format,
+		options,
+		f_init,
+		dump_node,
+		dumps + 2
+	);
+
+	for (size_t idx = 1; idx < 3; idx++) {
+
+		if (
+			retvals[idx] != retvals[0] ||
+			dumps[idx].members != dumps[0].members ||
+			strcmp(dumps[idx].text, dumps[0].text)
+		) {
+
+			printf(
+				"FAIL: %s for format %lu, case #%zu%s%s\n"
+				"  returned %d (generic: %d), %zu members (generic: %zu)\n"
+				"  expected:\n%s  got:\n%s",
+				idx == 1 ? "specialized copy" : "strip_ini_cache_with_options()",
+				(unsigned long int) parser->format_num,
+				case_num,
+				options ? ", with options" : "",
+				f_init ? ", with f_init" : "",
+				retvals[idx],
+				retvals[0],
+				dumps[idx].members,
+				dumps[0].members,
+				dumps[0].text,
+				dumps[idx].text
+			);
+
+			return 1;
+
+		}
+
+	}
+
+	return 0;
+
+}
+
+
+int main () {
+
+	static char implicit[] = "yes";
+
+	const IniParseOptions options = {
+		.implicit_value = implicit,
+		.implicit_v_len = 3,
+		.lowercase_mode = 1
+	};
+
+	int failed = 0;
+
+	for (size_t idx = 0; idx < sizeof(parsers) / sizeof(parsers[0]); idx++) {
+
+		for (size_t case_num = 0; case_num < sizeof(cases) / sizeof(cases[0]); case_num++) {
+
+			failed +=
+				check_case(parsers + idx, case_num, NULL, NULL) +
+				check_case(parsers + idx, case_num, NULL, count_members) +
+				check_case(parsers + idx, case_num, &options, NULL) +
+				check_case(parsers + idx, case_num, &options, count_members);
+
+		}
+
+	}
+
+	return failed ? 1 : 0;
+
+}